@@ -35,6 +35,10 @@
 //will be used.
 //
 //Additionally, special values can be stored at X,Y coordinates.
+//
+//Copies share the index storage until one of them is modified, so copying
+//an index (e.g. when a room is snapshotted) doesn't allocate or copy memory
+//unless the copy diverges from the original.
 
 #include "Types.h"
 #include "AttachableObject.h"
@@ -74,9 +78,14 @@ public:
 	void        SetAtIndex(const UINT index, const T val);
 
 private:
+	void        Release();
+	void        Share(const CCoordIndex_T<T>& Src);
+	inline void Unshare(const bool bKeepValues=true);
+
 	UINT dwCoordCount;
 	UINT  wCols, wRows;
 	T *   pbytIndex;
+	mutable UINT *pRefCount; //non-NULL when storage has been shared with another index
 };
 
 typedef CCoordIndex_T<BYTE> CCoordIndex;
@@ -99,6 +108,7 @@ CCoordIndex_T<T>::CCoordIndex_T(
 	, dwCoordCount(0L)
 	, wCols(0), wRows(0)
 	, pbytIndex(NULL)
+	, pRefCount(NULL)
 {
 	if (wCols && wRows)
 		VERIFY(Init(wCols, wRows, val));
@@ -111,17 +121,9 @@ CCoordIndex_T<T>::CCoordIndex_T(const CCoordIndex_T<T>& coordIndex)
 	, dwCoordCount(0L)
 	, wCols(0), wRows(0)
 	, pbytIndex(NULL)
+	, pRefCount(NULL)
 {
-	if (coordIndex.wCols && coordIndex.wRows)
-	{
-		if (Init(coordIndex.wCols, coordIndex.wRows))
-		{
-			//works only for primitive types
-			memcpy(this->pbytIndex, coordIndex.pbytIndex,
-					coordIndex.wCols * coordIndex.wRows * sizeof(T));
-			this->dwCoordCount = coordIndex.dwCoordCount;
-		}
-	}
+	Share(coordIndex);
 }
 
 //*******************************************************************************
@@ -129,24 +131,17 @@ template<typename T>
 CCoordIndex_T<T>::~CCoordIndex_T()
 //Destructor.
 {
-	delete[] this->pbytIndex;
+	Release();
 }
 
 //*******************************************************************************
 template<typename T>
 CCoordIndex_T<T>& CCoordIndex_T<T>::operator=(const CCoordIndex_T<T>& rhs)
 {
-	if (!rhs.wCols || !rhs.wRows)
+	if (this != &rhs)
 	{
-		delete[] this->pbytIndex;
-		this->pbytIndex = NULL;
-		this->wCols = rhs.wCols;
-		this->wRows = rhs.wRows;
-		this->dwCoordCount = 0;
-	} else if (Init(rhs.wCols, rhs.wRows)) {
-		//works only for primitive types
-		memcpy(this->pbytIndex, rhs.pbytIndex, rhs.GetArea() * sizeof(T));
-		this->dwCoordCount = rhs.dwCoordCount;
+		Release();
+		Share(rhs);
 	}
 	return *this;
 }
@@ -178,7 +173,7 @@ bool CCoordIndex_T<T>::Init(
 		return true;
 	}
 
-	delete[] this->pbytIndex;
+	Release();
 
 	//Create new index storage.
 	this->pbytIndex = new T[wSetCols * wSetRows];
@@ -218,6 +213,7 @@ void CCoordIndex_T<T>::AddAtIndex(
 {
 	ASSERT(val != 0); //zero is considered the reset value
 	ASSERT(this->pbytIndex);
+	Unshare();
 	if (this->pbytIndex[index] == 0) {
 		++this->dwCoordCount;
 		ASSERT(this->dwCoordCount <= GetArea());
@@ -232,7 +228,10 @@ void CCoordIndex_T<T>::Clear(const T val)	//[default=0]
 {
 	if (this->pbytIndex) {
 		if (val || !empty()) //if already empty, don't need to reset memory to 0 again
+		{
+			Unshare(false); //every value is overwritten
 			memset(this->pbytIndex, val, GetArea() * sizeof(T));
+		}
 	}
 	this->dwCoordCount = val ? GetArea() : 0;
 }
@@ -282,6 +281,7 @@ T& CCoordIndex_T<T>::GetAt(
 {
 	ASSERT(wX < this->wCols && wY < this->wRows);
 	ASSERT(this->pbytIndex);
+	Unshare(); //caller may write through the reference
 	return this->pbytIndex[wY * this->wCols + wX];
 }
 
@@ -314,6 +314,7 @@ void CCoordIndex_T<T>::Remove(
 	{
 		--this->dwCoordCount;
 		ASSERT(this->dwCoordCount < GetArea());
+		Unshare();
 		this->pbytIndex[dwSquareI] = 0;
 	}
 }
@@ -334,6 +335,7 @@ void CCoordIndex_T<T>::RemoveAll(
 	{
 		if (this->pbytIndex[dwSquareI] == val)
 		{
+			Unshare();
 			this->pbytIndex[dwSquareI] = 0;
 			--this->dwCoordCount;
 		}
@@ -355,6 +357,7 @@ void CCoordIndex_T<T>::Replace(const T oldVal, const T newVal)
 	{
 		if (this->pbytIndex[dwSquareI] == oldVal)
 		{
+			Unshare();
 			this->pbytIndex[dwSquareI] = newVal;
 			this->dwCoordCount += inc;
 		}
@@ -380,6 +383,7 @@ void CCoordIndex_T<T>::SetAtIndex(
 	const T val)
 {
 	ASSERT(this->pbytIndex);
+	Unshare();
 	if (this->pbytIndex[index])
 		--this->dwCoordCount;
 	this->pbytIndex[index] = val;
@@ -390,4 +394,67 @@ void CCoordIndex_T<T>::SetAtIndex(
 	}
 }
 
+//
+//CCoordIndex private template methods.
+//
+
+//*******************************************************************************
+template<typename T>
+void CCoordIndex_T<T>::Release()
+//Gives up this index's hold on its storage, freeing it if no other index shares it.
+{
+	if (!this->pRefCount)
+	{
+		delete[] this->pbytIndex;
+	} else if (!--*this->pRefCount) {
+		delete[] this->pbytIndex;
+		delete this->pRefCount;
+	}
+	this->pbytIndex = NULL;
+	this->pRefCount = NULL;
+	this->wCols = this->wRows = 0;
+	this->dwCoordCount = 0;
+}
+
+//*******************************************************************************
+template<typename T>
+void CCoordIndex_T<T>::Share(const CCoordIndex_T<T>& Src)
+//Makes this (empty) index use the same storage as Src.
+{
+	ASSERT(!this->pbytIndex);
+	this->wCols = Src.wCols;
+	this->wRows = Src.wRows;
+	this->dwCoordCount = Src.dwCoordCount;
+	if (!Src.pbytIndex)
+		return;
+
+	if (!Src.pRefCount)
+		Src.pRefCount = new UINT(1);
+	++*Src.pRefCount;
+	this->pRefCount = Src.pRefCount;
+	this->pbytIndex = Src.pbytIndex;
+}
+
+//*******************************************************************************
+template<typename T>
+void CCoordIndex_T<T>::Unshare(
+//Call before modifying the index.  If the storage is shared, this index gets
+//its own copy of it.
+//
+//Params:
+	const bool bKeepValues) //(in) whether the current values must be copied [default=true]
+{
+	if (!this->pRefCount || *this->pRefCount == 1)
+		return;
+
+	const UINT area = GetArea();
+	T *pNewIndex = new T[area];
+	if (bKeepValues) //works only for primitive types
+		memcpy(pNewIndex, this->pbytIndex, area * sizeof(T));
+
+	--*this->pRefCount;
+	this->pRefCount = NULL;
+	this->pbytIndex = pNewIndex;
+}
+
 #endif //...#ifndef COORDINDEX_H
@@ -32,79 +32,164 @@
 #ifndef COORDSET_H
 #define COORDSET_H
 
+#include <cstring>
+#include <iterator>
 #include <set>
 
+//Set of coords, iterated in (x,y) order.
+//
+//Coords within the bounds of a room are kept in a bitmap with one 64-bit
+//word per column (bit y of column x is set when (x,y) is a member), so
+//insertion, membership, union and difference don't allocate.
+//Coords outside of the bitmap's range are kept in an ordered overflow set.
 class CCoordSet : public CAttachableObject
 {
 public:
-	typedef std::set<ROOMCOORD> CoordSet;
-	typedef CoordSet::const_iterator const_iterator;
+	static const UINT BITMAP_COLS = 64; //must exceed room width
+	static const UINT BITMAP_ROWS = 64; //bits per column word; must exceed room height
 
-	CCoordSet() {}
-	CCoordSet(const UINT wX, const UINT wY) {insert(wX,wY);}
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef ROOMCOORD value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const ROOMCOORD* pointer;
+		typedef const ROOMCOORD& reference;
+
+		const_iterator() : pSet(NULL), bEnd(true) {}
+		const_iterator(const CCoordSet *pSet, const bool bEnd)
+			: pSet(pSet), bEnd(bEnd)
+		{
+			if (!bEnd)
+				this->bEnd = !pSet->getNext(NULL, this->coord);
+		}
 
-	inline void clear() {this->data.clear();}
+		inline reference operator*() const {return this->coord;}
+		inline pointer operator->() const {return &this->coord;}
+
+		const_iterator& operator++() {
+			const ROOMCOORD prev = this->coord;
+			this->bEnd = !this->pSet->getNext(&prev, this->coord);
+			return *this;
+		}
+		const_iterator operator++(int) {
+			const_iterator prev(*this);
+			++(*this);
+			return prev;
+		}
+
+		bool operator==(const const_iterator& rhs) const {
+			if (this->bEnd || rhs.bEnd)
+				return this->bEnd == rhs.bEnd;
+			return this->coord == rhs.coord;
+		}
+		bool operator!=(const const_iterator& rhs) const {return !operator==(rhs);}
+
+	private:
+		const CCoordSet *pSet;
+		ROOMCOORD coord;
+		bool bEnd;
+	};
+
+	CCoordSet() : wBeginCol(BITMAP_COLS), wEndCol(0), dwBitCount(0) {
+		memset(this->columns, 0, sizeof(this->columns));
+	}
+	CCoordSet(const UINT wX, const UINT wY) : wBeginCol(BITMAP_COLS), wEndCol(0), dwBitCount(0) {
+		memset(this->columns, 0, sizeof(this->columns));
+		insert(wX,wY);
+	}
+
+	void clear()
+	{
+		if (this->wBeginCol < this->wEndCol)
+			memset(this->columns + this->wBeginCol, 0,
+					(this->wEndCol - this->wBeginCol) * sizeof(QWORD));
+		this->wBeginCol = BITMAP_COLS;
+		this->wEndCol = 0;
+		this->dwBitCount = 0;
+		this->overflow.clear();
+	}
 
 	inline bool insert(const UINT wX, const UINT wY)
 	{
-		return insert(ROOMCOORD(wX,wY));
+		if (!inBitmap(wX, wY))
+			return this->overflow.insert(ROOMCOORD(wX,wY)).second;
+
+		QWORD& column = this->columns[wX];
+		const QWORD bit = QWORD(1) << wY;
+		if (column & bit)
+			return false;
+		column |= bit;
+		++this->dwBitCount;
+		extendColumnRange(wX, wX + 1);
+		return true;
 	}
 	inline bool insert(ROOMCOORD const &cc)
 	{
-		return this->data.insert(cc).second;
+		return insert(cc.wX, cc.wY);
 	}
 	inline void insert(CCoordSet::const_iterator begin, CCoordSet::const_iterator end)
 	{
-		this->data.insert(begin, end);
+		for ( ; begin != end; ++begin)
+			insert(*begin);
 	}
 
-	inline bool empty() const {return this->data.empty();}
-	inline int size() const {return this->data.size();}
+	inline bool empty() const {return !this->dwBitCount && this->overflow.empty();}
+	inline int size() const {return int(this->dwBitCount + this->overflow.size());}
 
 	inline bool erase(const UINT wX, const UINT wY)
 	{
-		return erase(ROOMCOORD(wX,wY));
+		if (!inBitmap(wX, wY))
+			return this->overflow.erase(ROOMCOORD(wX,wY)) != 0;
+
+		QWORD& column = this->columns[wX];
+		const QWORD bit = QWORD(1) << wY;
+		if (!(column & bit))
+			return false;
+		column &= ~bit;
+		--this->dwBitCount;
+		return true;
 	}
 	inline bool erase(ROOMCOORD const &cc)
 	{
-		return this->data.erase(cc) != 0;
+		return erase(cc.wX, cc.wY);
 	}
 
 	inline bool first(UINT &wX, UINT &wY) const
 	{
-		if (empty())
+		ROOMCOORD coord;
+		if (!getNext(NULL, coord))
 			return false;
-		CoordSet::const_iterator iter = this->data.begin();
-		wX = iter->wX; wY = iter->wY;
+		wX = coord.wX; wY = coord.wY;
 		return true;
 	}
 	bool pop_first(UINT &wX, UINT &wY)
 	{
-		if (empty())
+		if (!first(wX, wY))
 			return false;
-		CoordSet::iterator iter = this->data.begin();
-		wX = iter->wX; wY = iter->wY;
-		this->data.erase(iter);
+		erase(wX, wY);
 		return true;
 	}
 
 	inline bool has(const UINT wX, const UINT wY) const
 	{
-		return has(ROOMCOORD(wX, wY));
+		if (!inBitmap(wX, wY))
+			return this->overflow.count(ROOMCOORD(wX,wY)) != 0;
+		return (this->columns[wX] & (QWORD(1) << wY)) != 0;
 	}
 	inline bool has(ROOMCOORD const &cc) const
 	{
-		return this->data.count(cc) != 0;
+		return has(cc.wX, cc.wY);
 	}
 
-	inline const_iterator begin() const {return this->data.begin();}
-	inline const_iterator end() const {return this->data.end();}
+	inline const_iterator begin() const {return const_iterator(this, false);}
+	inline const_iterator end() const {return const_iterator(this, true);}
 
 	void AddTo(CCoordIndex &coordIndex) const
 	//Places all the coords in this object in coordIndex.
 	{
-		for (const_iterator trav = this->data.begin();
-				trav != this->data.end(); ++trav)
+		for (const_iterator trav = begin(); trav != end(); ++trav)
 		{
 			//ASSUME: (wX,wY) are within the bounds of coordIndex
 			coordIndex.Add(trav->wX, trav->wY);
@@ -133,22 +218,146 @@ public:
 	CCoordSet& operator+=(const CCoordSet& that)
 	//Adds all instances of coords in 'that' to this.
 	{
-		for (const_iterator iter = that.data.begin();
-				iter != that.data.end(); ++iter)
-			insert(*iter);
+		if (&that == this)
+			return *this;
+		if (that.dwBitCount)
+		{
+			for (UINT wX = that.wBeginCol; wX < that.wEndCol; ++wX)
+			{
+				const QWORD added = that.columns[wX] & ~this->columns[wX];
+				if (added)
+				{
+					this->columns[wX] |= added;
+					this->dwBitCount += bitCount(added);
+				}
+			}
+			extendColumnRange(that.wBeginCol, that.wEndCol);
+		}
+		if (!that.overflow.empty())
+			this->overflow.insert(that.overflow.begin(), that.overflow.end());
 		return *this;
 	}
 	CCoordSet& operator-=(const CCoordSet& that)
 	//Removes all instances of coords in 'that' from this.
 	{
-		for (const_iterator iter = that.data.begin();
-				iter != that.data.end(); ++iter)
-			erase(*iter);
+		if (&that == this)
+		{
+			clear();
+			return *this;
+		}
+		if (this->dwBitCount && that.dwBitCount)
+		{
+			const UINT wBegin = that.wBeginCol > this->wBeginCol ? that.wBeginCol : this->wBeginCol;
+			const UINT wEnd = that.wEndCol < this->wEndCol ? that.wEndCol : this->wEndCol;
+			for (UINT wX = wBegin; wX < wEnd; ++wX)
+			{
+				const QWORD removed = this->columns[wX] & that.columns[wX];
+				if (removed)
+				{
+					this->columns[wX] &= ~removed;
+					this->dwBitCount -= bitCount(removed);
+				}
+			}
+		}
+		if (!this->overflow.empty())
+			for (std::set<ROOMCOORD>::const_iterator iter = that.overflow.begin();
+					iter != that.overflow.end(); ++iter)
+				this->overflow.erase(*iter);
 		return *this;
 	}
 
 private:
-	CoordSet data;
+	static inline bool inBitmap(const UINT wX, const UINT wY)
+	{
+		return wX < BITMAP_COLS && wY < BITMAP_ROWS;
+	}
+
+	inline void extendColumnRange(const UINT wBegin, const UINT wEnd)
+	{
+		if (wBegin < this->wBeginCol)
+			this->wBeginCol = wBegin;
+		if (wEnd > this->wEndCol)
+			this->wEndCol = wEnd;
+	}
+
+	static inline UINT bitCount(QWORD w)
+	{
+		w = w - ((w >> 1) & 0x5555555555555555ULL);
+		w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+		w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return UINT((w * 0x0101010101010101ULL) >> 56);
+	}
+
+	static inline UINT lowestBitIndex(const QWORD w)
+	//Pre-condition: w != 0
+	{
+		static const BYTE deBruijnIndex[64] = {
+			 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+			62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+			63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+			46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+		};
+		return deBruijnIndex[((w & (~w + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+	}
+
+	bool getNext(const ROOMCOORD *pAfter, ROOMCOORD &next) const
+	//Outputs the first member following pAfter in (x,y) order,
+	//or the first member of the set when pAfter is NULL.
+	//
+	//Returns: whether there is such a member
+	{
+		bool bFound = false;
+
+		//Search the bitmap.
+		if (this->dwBitCount && (!pAfter || pAfter->wX < this->wEndCol))
+		{
+			UINT wX = this->wBeginCol;
+			if (pAfter && pAfter->wX >= this->wBeginCol)
+			{
+				//Check the rest of the current column first.
+				wX = pAfter->wX;
+				if (pAfter->wY < BITMAP_ROWS - 1)
+				{
+					const QWORD later = this->columns[wX] & ~((QWORD(2) << pAfter->wY) - 1);
+					if (later)
+					{
+						next.wX = wX;
+						next.wY = lowestBitIndex(later);
+						bFound = true;
+					}
+				}
+				++wX;
+			}
+			for ( ; !bFound && wX < this->wEndCol; ++wX)
+			{
+				if (this->columns[wX])
+				{
+					next.wX = wX;
+					next.wY = lowestBitIndex(this->columns[wX]);
+					bFound = true;
+				}
+			}
+		}
+
+		//Coords outside the bitmap might come first.
+		if (!this->overflow.empty())
+		{
+			std::set<ROOMCOORD>::const_iterator iter = pAfter ?
+					this->overflow.upper_bound(*pAfter) : this->overflow.begin();
+			if (iter != this->overflow.end() && (!bFound || *iter < next))
+			{
+				next = *iter;
+				bFound = true;
+			}
+		}
+
+		return bFound;
+	}
+
+	QWORD columns[BITMAP_COLS];
+	UINT wBeginCol, wEndCol; //range of columns that might have set bits
+	UINT dwBitCount;         //number of coords in the bitmap
+	std::set<ROOMCOORD> overflow; //coords outside of the bitmap's range
 };
 
 #endif //...#ifndef COORDSET_H
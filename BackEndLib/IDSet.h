@@ -28,6 +28,12 @@
 //IDSet.h
 //Declarations for CIDSet.
 //Class for managing a set of ID values.
+//
+//IDs are kept in a sorted array, so iteration is in ascending order and set
+//operations between two CIDSets are linear merges.  Small sets are stored
+//inline without any heap allocation.
+//
+//NOTE: Unlike std::set, adding or removing IDs invalidates iterators.
 
 #ifndef IDSET_H
 #define IDSET_H
@@ -35,117 +41,261 @@
 #include "Types.h"
 #include "IDList.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <set>
 #include <vector>
 
 class CIDSet
 {
 public:
-	typedef std::set<UINT> IDSet;
-	typedef IDSet::iterator iterator;
-	typedef IDSet::const_iterator const_iterator;
-	typedef IDSet::const_reverse_iterator const_reverse_iterator;
-
-	CIDSet() {}
-	CIDSet(const CIDSet& that) {this->ids = that.ids;}
-	CIDSet(const std::vector<UINT>& idVector) {
-		const size_t size = idVector.size();
-		for (UINT i=0; i<size; ++i)
-			this->ids.insert(idVector[i]);
-	}
-	CIDSet(const UINT dwID) {this->ids.insert(dwID);}
-
-	inline bool  empty() const {return this->ids.empty();}
-	inline bool  has(const UINT dwID) const {return this->ids.count(dwID) != 0;}
-	inline UINT  size() const {return this->ids.size();}
-
-	inline void  clear() {this->ids.clear();}
-	inline int   erase(const UINT dwID) {return this->ids.erase(dwID);}
+	typedef const UINT* iterator;
+	typedef const UINT* const_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	CIDSet() : pIDs(inlineIDs), count(0), capacity(INLINE_CAPACITY) {}
+	CIDSet(const CIDSet& that) : pIDs(inlineIDs), count(0), capacity(INLINE_CAPACITY) {
+		assign(that.pIDs, that.count);
+	}
+	CIDSet(const std::vector<UINT>& idVector) : pIDs(inlineIDs), count(0), capacity(INLINE_CAPACITY) {
+		if (idVector.empty())
+			return;
+		assign(&idVector[0], UINT(idVector.size()));
+		std::sort(this->pIDs, this->pIDs + this->count);
+		this->count = UINT(std::unique(this->pIDs, this->pIDs + this->count) - this->pIDs);
+	}
+	CIDSet(const UINT dwID) : pIDs(inlineIDs), count(1), capacity(INLINE_CAPACITY) {
+		this->inlineIDs[0] = dwID;
+	}
+	~CIDSet() {
+		if (this->pIDs != this->inlineIDs)
+			delete[] this->pIDs;
+	}
+
+	inline bool  empty() const {return this->count == 0;}
+	inline bool  has(const UINT dwID) const {return std::binary_search(begin(), end(), dwID);}
+	inline UINT  size() const {return this->count;}
+
+	inline void  clear() {this->count = 0;}
+	int erase(const UINT dwID) {
+		UINT *pFound = lowerBound(dwID);
+		if (pFound == this->pIDs + this->count || *pFound != dwID)
+			return 0;
+		eraseAt(UINT(pFound - this->pIDs));
+		return 1;
+	}
 	inline iterator erase(const iterator iter) {
-#if defined _MSC_VER
-		return this->ids.erase(iter);
-#else
-		iterator newiter=iter;
-		++newiter;
-		this->ids.erase(iter);
-		return newiter;
-#endif
-	}
-
-	bool operator == (const CIDSet &Src) const {return this->ids == Src.ids;}
-	bool operator != (const CIDSet &Src) const {return this->ids != Src.ids;}
+		const UINT index = UINT(iter - this->pIDs);
+		eraseAt(index);
+		return this->pIDs + index;
+	}
+
+	bool operator == (const CIDSet &Src) const {
+		return this->count == Src.count && std::equal(begin(), end(), Src.begin());
+	}
+	bool operator != (const CIDSet &Src) const {return !operator==(Src);}
 	CIDSet& operator = (const CIDSet &Src) {
-		clear();
-		return operator+=(Src);
+		if (this != &Src)
+			assign(Src.pIDs, Src.count);
+		return *this;
 	}
 	CIDSet& operator += (const UINT dwID) {
-		this->ids.insert(dwID);
+		//IDs are most often added in ascending order.
+		if (!this->count || dwID > this->pIDs[this->count - 1])
+		{
+			reserve(this->count + 1);
+			this->pIDs[this->count++] = dwID;
+			return *this;
+		}
+		UINT *pFound = lowerBound(dwID);
+		if (*pFound != dwID)
+			insertAt(UINT(pFound - this->pIDs), dwID);
 		return *this;
 	}
 	CIDSet& operator += (const CIDSet &Src) {
-		for (const_iterator iter = Src.begin(); iter != Src.end(); ++iter)
-			this->ids.insert(*iter);
+		if (Src.count <= MERGE_THRESHOLD || this == &Src)
+		{
+			for (const_iterator iter = Src.begin(); iter != Src.end(); ++iter)
+				operator+=(*iter);
+		} else if (!this->count) {
+			assign(Src.pIDs, Src.count);
+		} else if (Src.pIDs[0] > this->pIDs[this->count - 1]) {
+			//Append.
+			reserve(this->count + Src.count);
+			memcpy(this->pIDs + this->count, Src.pIDs, Src.count * sizeof(UINT));
+			this->count += Src.count;
+		} else {
+			//Merge into a new buffer.
+			const UINT newCapacity = this->count + Src.count;
+			UINT *pMerged = new UINT[newCapacity];
+			const UINT *pEnd = std::set_union(begin(), end(), Src.begin(), Src.end(), pMerged);
+			this->count = UINT(pEnd - pMerged);
+			if (this->pIDs != this->inlineIDs)
+				delete[] this->pIDs;
+			this->pIDs = pMerged;
+			this->capacity = newCapacity;
+		}
 		return *this;
 	}
 	CIDSet& operator += (const CIDList &Src) {
 		IDNODE *pNode = Src.Get(0);
 		while (pNode)
 		{
-			this->ids.insert(pNode->dwID);
+			operator+=(pNode->dwID);
 			pNode = pNode->pNext;
 		}
 		return *this;
 	}
 	CIDSet& operator -= (const UINT dwID) {
-		this->ids.erase(dwID);
+		erase(dwID);
 		return *this;
 	}
 	CIDSet& operator -= (const CIDSet &Src) {
-		for (const_iterator iter = Src.begin(); iter != Src.end(); ++iter)
-			this->ids.erase(*iter);
+		if (this == &Src)
+		{
+			clear();
+		} else if (Src.count <= MERGE_THRESHOLD) {
+			for (const_iterator iter = Src.begin(); iter != Src.end(); ++iter)
+				erase(*iter);
+		} else if (this->count) {
+			//Compact the IDs not in Src in place.
+			UINT *pWrite = this->pIDs;
+			const UINT *pRead = this->pIDs, *pEnd = this->pIDs + this->count;
+			const_iterator src = Src.begin();
+			while (pRead != pEnd)
+			{
+				while (src != Src.end() && *src < *pRead)
+					++src;
+				if (src == Src.end() || *src != *pRead)
+					*pWrite++ = *pRead;
+				++pRead;
+			}
+			this->count = UINT(pWrite - this->pIDs);
+		}
 		return *this;
 	}
 
 	//Removes IDs from this set that aren't members of Filter.
 	void intersect(const CIDSet &Filter)
 	{
-		std::set<UINT> filteredIDs;
-		for (const_iterator iter = Filter.begin(); iter != Filter.end(); ++iter)
-			if (has(*iter))
-				filteredIDs.insert(*iter);
-		this->ids = filteredIDs;
+		UINT *pWrite = this->pIDs;
+		const UINT *pRead = this->pIDs, *pEnd = this->pIDs + this->count;
+		const_iterator filter = Filter.begin();
+		while (pRead != pEnd && filter != Filter.end())
+		{
+			if (*pRead < *filter)
+				++pRead;
+			else if (*filter < *pRead)
+				++filter;
+			else {
+				*pWrite++ = *pRead++;
+				++filter;
+			}
+		}
+		this->count = UINT(pWrite - this->pIDs);
 	}
 
 	//Does this set contain all IDs that a second set has.
 	bool contains(const CIDSet &against) const
 	{
-		for (const_iterator iter = against.begin(); iter != against.end(); ++iter)
-			if (!has(*iter))
-				return false;
-		return true;
+		if (against.count > this->count)
+			return false;
+		if (against.count <= MERGE_THRESHOLD)
+		{
+			for (const_iterator iter = against.begin(); iter != against.end(); ++iter)
+				if (!has(*iter))
+					return false;
+			return true;
+		}
+		return std::includes(begin(), end(), against.begin(), against.end());
 	}
 	//Does this set contain any IDs that a second set has.
 	bool containsAny(const CIDSet &against) const
 	{
-		for (const_iterator iter = against.begin(); iter != against.end(); ++iter)
-			if (has(*iter))
+		if (against.count <= MERGE_THRESHOLD)
+		{
+			for (const_iterator iter = against.begin(); iter != against.end(); ++iter)
+				if (has(*iter))
+					return true;
+			return false;
+		}
+		const_iterator mine = begin(), theirs = against.begin();
+		while (mine != end() && theirs != against.end())
+		{
+			if (*mine < *theirs)
+				++mine;
+			else if (*theirs < *mine)
+				++theirs;
+			else
 				return true;
+		}
 		return false;
 	}
 
-	inline iterator begin() {return this->ids.begin();}
-	inline const_iterator begin() const {return this->ids.begin();}
-	inline iterator end() {return this->ids.end();}
-	inline const_iterator end() const {return this->ids.end();}
-	inline const_reverse_iterator rbegin() const {return this->ids.rbegin();}
-	inline const_reverse_iterator rend() const {return this->ids.rend();}
+	inline iterator begin() {return this->pIDs;}
+	inline const_iterator begin() const {return this->pIDs;}
+	inline iterator end() {return this->pIDs + this->count;}
+	inline const_iterator end() const {return this->pIDs + this->count;}
+	inline const_reverse_iterator rbegin() const {return const_reverse_iterator(end());}
+	inline const_reverse_iterator rend() const {return const_reverse_iterator(begin());}
 
-	inline UINT getFirst() const {return size() ? *begin() : 0;}
-	inline UINT getLast() const {return size() ? *rbegin() : 0;}
-	inline UINT getMax() const {return size() ? *(this->ids.rbegin()) : 0;}
+	inline UINT getFirst() const {return this->count ? this->pIDs[0] : 0;}
+	inline UINT getLast() const {return this->count ? this->pIDs[this->count - 1] : 0;}
+	inline UINT getMax() const {return getLast();}
 
 private:
-	std::set<UINT> ids;
+	//Sets with up to this many IDs don't allocate.
+	static const UINT INLINE_CAPACITY = 4;
+
+	//Operations with a set no larger than this are done ID by ID
+	//rather than by merging.
+	static const UINT MERGE_THRESHOLD = 8;
+
+	void assign(const UINT *pSrc, const UINT srcCount) {
+		this->count = 0;
+		reserve(srcCount);
+		if (srcCount)
+			memcpy(this->pIDs, pSrc, srcCount * sizeof(UINT));
+		this->count = srcCount;
+	}
+
+	void eraseAt(const UINT index) {
+		memmove(this->pIDs + index, this->pIDs + index + 1,
+				(this->count - index - 1) * sizeof(UINT));
+		--this->count;
+	}
+
+	void insertAt(const UINT index, const UINT dwID) {
+		reserve(this->count + 1);
+		memmove(this->pIDs + index + 1, this->pIDs + index,
+				(this->count - index) * sizeof(UINT));
+		this->pIDs[index] = dwID;
+		++this->count;
+	}
+
+	inline UINT* lowerBound(const UINT dwID) const {
+		return std::lower_bound(this->pIDs, this->pIDs + this->count, dwID);
+	}
+
+	void reserve(const UINT minCapacity) {
+		if (minCapacity <= this->capacity)
+			return;
+		UINT newCapacity = this->capacity * 2;
+		if (newCapacity < minCapacity)
+			newCapacity = minCapacity;
+		UINT *pNewIDs = new UINT[newCapacity];
+		if (this->count)
+			memcpy(pNewIDs, this->pIDs, this->count * sizeof(UINT));
+		if (this->pIDs != this->inlineIDs)
+			delete[] this->pIDs;
+		this->pIDs = pNewIDs;
+		this->capacity = newCapacity;
+	}
+
+	UINT *pIDs;     //sorted IDs; points to inlineIDs until more room is needed
+	UINT count, capacity;
+	UINT inlineIDs[INLINE_CAPACITY];
 };
 
 #endif //...#ifndef IDSET_H
@@ -2963,6 +2963,7 @@ void CCharacterDialogWidget::EditCustomCharacters()
 	CEditRoomScreen *pEditRoomScreen = DYN_CAST(CEditRoomScreen*, CScreen*,
 			g_pTheSM->GetScreen(SCR_EditRoom));
 	ASSERT(pEditRoomScreen);
+	pEditRoomScreen->CharactersChanging(); //keep the characters' current state for undo
 
 	UINT dwTagNo;
 	bool bLoop=true;
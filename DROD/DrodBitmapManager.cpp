@@ -70,6 +70,9 @@ const char textureTileNames[TEXTURE_COUNT][13] = {
 
 const UINT TI_DONT_USE = (UINT)-1;
 
+//Decoded style images are kept up to this size, enough for a few styles' tiles and textures.
+const UINT MAX_STYLE_IMAGE_CACHE_BYTES = 64 * 1024 * 1024;
+
 //
 //Public methods.
 //
@@ -79,6 +82,7 @@ CDrodBitmapManager::CDrodBitmapManager()
 //Constructor.
 	: CBitmapManager()
 	, bStyleIsFrozen(false)
+	, dwStyleImageCacheBytes(0)
 {
 	//192-gray is the transparent pixel color key.
 	CBitmapManager::TransColor[0] = CBitmapManager::TransColor[1] = CBitmapManager::TransColor[2] = 192;
@@ -112,6 +116,7 @@ CDrodBitmapManager::~CDrodBitmapManager()
 	for (UINT wI = TEXTURE_COUNT; wI--;)
 		if (this->pTextures[wI])
 			SDL_FreeSurface(this->pTextures[wI]);
+	ClearStyleImageCache();
 }
 
 //*****************************************************************************
@@ -309,6 +314,9 @@ bool CDrodBitmapManager::LoadGeneralTileImages(
 	if (!f.GetGameProfileString(INISection::Graphics, "General", tiles))
 		return false;
 
+	if (!pLoadTileSet || !pLoadTileSet->empty())
+		PrefetchStyleImages(vector<WSTRING>(tiles.begin(), tiles.end()));
+
 	CIDSet ignoredTiles;
 	list<WSTRING>::const_iterator iStr;
 	for (iStr = tiles.begin(); iStr != tiles.end(); ++iStr)
@@ -340,8 +348,13 @@ bool CDrodBitmapManager::LoadTileImagesForStyle(
 		return true;	//already loaded
 
 	//If forcing a reload, general tiles is loaded first, and then style-specific tiles.
-	if (bForceReload && !LoadGeneralTileImages())
-		return false;
+	//Image files may have changed, so they are decoded again.
+	if (bForceReload)
+	{
+		ClearStyleImageCache();
+		if (!LoadGeneralTileImages())
+			return false;
+	}
 
 	//Lookup base filename given for style.
 	CFiles f;
@@ -352,6 +365,38 @@ bool CDrodBitmapManager::LoadTileImagesForStyle(
 	//Load the tilesets for this style in listed order.
 	ASSERT(!tiles.empty());
 
+	//Decode this style's tile and texture files together.
+	{
+		vector<WSTRING> styleImages;
+		WSTRING wstrFilepath;
+		list<WSTRING>::const_iterator iStr;
+		for (iStr = tiles.begin(); iStr != tiles.end(); ++iStr)
+		{
+			const WSTRING wstrDefault = *iStr + wszTILES;
+			wstrFilepath.resize(0);
+			styleImages.push_back(GetImageFilepath(wstrDefault.c_str(), wstrFilepath) ?
+					wstrDefault : *iStr);
+		}
+		WSTRING wstrTextureName;
+		for (UINT wI=TEXTURE_COUNT; wI--; )
+		{
+			if (wI == FLOOR_IMAGE || wI == OVERHEAD_IMAGE)
+				continue;
+			AsciiToUnicode(textureTileNames[wI], wstrTextureName);
+			for (list<WSTRING>::reverse_iterator rStr = tiles.rbegin(); rStr != tiles.rend(); ++rStr)
+			{
+				const WSTRING wstrFilename = *rStr + wstrTextureName;
+				wstrFilepath.resize(0);
+				if (GetImageFilepath(wstrFilename.c_str(), wstrFilepath))
+				{
+					styleImages.push_back(wstrFilename);
+					break;
+				}
+			}
+		}
+		PrefetchStyleImages(styleImages);
+	}
+
 	CIDSet styleTiles;
 	for (list<WSTRING>::const_iterator iStr = tiles.begin(); iStr != tiles.end(); ++iStr)
 	{
@@ -795,6 +840,84 @@ SDL_Surface* CDrodBitmapManager::LoadPNGSurface(
 // Private methods.
 //
 
+//**********************************************************************************
+void CDrodBitmapManager::AddStyleImage(
+//Caches a decoded style image as the most recently used one.
+//
+//Params:
+	const WSTRING& wstrName,  //(in) Name of the image, not including extension.
+	SDL_Surface *pSurface)    //(in) Image, or NULL if none exists.  The cache takes ownership.
+{
+	CACHEDSTYLEIMAGE image;
+	image.wstrName = wstrName;
+	image.pSurface = pSurface;
+	image.dwBytes = pSurface ? pSurface->pitch * pSurface->h : 0;
+	this->styleImageCache.push_front(image);
+	this->dwStyleImageCacheBytes += image.dwBytes;
+
+	//Evict least recently used images, but never the one just added.
+	while (this->dwStyleImageCacheBytes > MAX_STYLE_IMAGE_CACHE_BYTES &&
+			this->styleImageCache.size() > 1)
+	{
+		const CACHEDSTYLEIMAGE& oldest = this->styleImageCache.back();
+		if (oldest.pSurface)
+			SDL_FreeSurface(oldest.pSurface);
+		this->dwStyleImageCacheBytes -= oldest.dwBytes;
+		this->styleImageCache.pop_back();
+	}
+}
+
+//**********************************************************************************
+void CDrodBitmapManager::ClearStyleImageCache()
+//Frees all cached style images.
+//Call whenever image data not belonging to a hold is added, replaced or removed,
+//as the cache would otherwise keep returning images (or misses) by name.
+{
+	for (list<CACHEDSTYLEIMAGE>::const_iterator image = this->styleImageCache.begin();
+			image != this->styleImageCache.end(); ++image)
+		if (image->pSurface)
+			SDL_FreeSurface(image->pSurface);
+	this->styleImageCache.clear();
+	this->dwStyleImageCacheBytes = 0;
+}
+
+//**********************************************************************************
+list<CACHEDSTYLEIMAGE>::iterator CDrodBitmapManager::FindStyleImage(const WCHAR *wszName)
+//Returns: cache entry for the named image, or end() if it isn't cached
+{
+	list<CACHEDSTYLEIMAGE>::iterator image;
+	for (image = this->styleImageCache.begin(); image != this->styleImageCache.end(); ++image)
+		if (!image->wstrName.compare(wszName))
+			break;
+	return image;
+}
+
+//**********************************************************************************
+SDL_Surface* CDrodBitmapManager::GetStyleImageSurface(
+//Gets a tile or texture image, decoding it only if it isn't among the recently used ones.
+//
+//Params:
+	const WCHAR *wszName)   //(in)   Name of the image, not including extension.
+//
+//Returns:
+//Cached surface, which the caller must not free or modify, or NULL if no image exists.
+{
+	ASSERT(wszName);
+
+	list<CACHEDSTYLEIMAGE>::iterator image = FindStyleImage(wszName);
+	if (image != this->styleImageCache.end())
+	{
+		//Move to front of the LRU order.
+		if (image != this->styleImageCache.begin())
+			this->styleImageCache.splice(this->styleImageCache.begin(),
+					this->styleImageCache, image);
+		return this->styleImageCache.front().pSurface;
+	}
+
+	AddStyleImage(wszName, LoadImageSurface(wszName, 0));
+	return this->styleImageCache.front().pSurface;
+}
+
 //**********************************************************************************
 bool CDrodBitmapManager::LoadTexture(
 //Loads an image by name into the texture enumeration.
@@ -806,8 +929,16 @@ bool CDrodBitmapManager::LoadTexture(
 	static SDL_Rect dest = MAKE_SDL_RECT(0, 0, CX_TILE, CY_TILE);
 	SDL_Surface* &texture = this->pTextures[wI];
 	if (texture)
+	{
 		SDL_FreeSurface(texture);
-	texture = LoadImageSurface(wstrFilename.c_str(), 0);
+		texture = NULL;
+	}
+
+	//Textures may have their blend mode changed, so use a copy of the cached image.
+	SDL_Surface *pImage = GetStyleImageSurface(wstrFilename.c_str());
+	if (!pImage)
+		return false;
+	texture = SDL_ConvertSurface(pImage, pImage->format, 0);
 	if (!texture)
 		return false;
 
@@ -834,6 +965,30 @@ bool CDrodBitmapManager::LoadTexture(
 	return true;
 }
 
+//**********************************************************************************
+void CDrodBitmapManager::PrefetchStyleImages(
+//Decodes the named images that aren't cached yet all at once, so they can be
+//decoded in parallel.  Names without an image file are left for
+//GetStyleImageSurface to look up in the DB.
+//
+//Params:
+	const vector<WSTRING>& names) //(in) images about to be loaded
+{
+	vector<WSTRING> uncachedNames;
+	for (vector<WSTRING>::const_iterator name = names.begin(); name != names.end(); ++name)
+		if (FindStyleImage(name->c_str()) == this->styleImageCache.end() &&
+				std::find(uncachedNames.begin(), uncachedNames.end(), *name) == uncachedNames.end())
+			uncachedNames.push_back(*name);
+	if (uncachedNames.size() < 2)
+		return; //nothing to decode in parallel
+
+	vector<SDL_Surface*> surfaces;
+	LoadImageSurfaces(uncachedNames, surfaces);
+	for (UINT wI = 0; wI < uncachedNames.size(); ++wI)
+		if (surfaces[wI])
+			AddStyleImage(uncachedNames[wI], surfaces[wI]);
+}
+
 //**********************************************************************************
 bool CDrodBitmapManager::LoadTileImages(
 //Loads a tile image file.  If tile images that it contains are already loaded,
@@ -852,7 +1007,7 @@ bool CDrodBitmapManager::LoadTileImages(
 
 	//Load the source bitmap containing tile images.
 	UINT wCols, wRows;
-	SDL_Surface *pSrcSurface = LoadImageSurface(wszName, 0);
+	SDL_Surface *pSrcSurface = GetStyleImageSurface(wszName);
 	if (!pSrcSurface) return false;
 	ASSERT(pSrcSurface->w % CX_TILE == 0);
 	ASSERT(pSrcSurface->h % CY_TILE == 0);
@@ -919,7 +1074,5 @@ bool CDrodBitmapManager::LoadTileImages(
 	for (wSurfaceIndex = CDrodBitmapManager::NUM_TILEIMAGESURFACES; wSurfaceIndex--; )
 		UnlockTileImagesSurface(wSurfaceIndex);
 
-	SDL_FreeSurface(pSrcSurface);
-
 	return true;
 }
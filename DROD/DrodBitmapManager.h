@@ -59,6 +59,14 @@ extern const char textureTileNames[TEXTURE_COUNT][13];
 
 #define TRANSPARENT_RGB CBitmapManager::TransColor[0], CBitmapManager::TransColor[1], CBitmapManager::TransColor[2]
 
+//Decoded style image, kept so switching back to a recent style needn't decode it again.
+struct CACHEDSTYLEIMAGE
+{
+	WSTRING wstrName;
+	SDL_Surface *pSurface; //NULL if no image by this name was found
+	UINT dwBytes;
+};
+
 //****************************************************************************
 class CDrodBitmapManager : public CBitmapManager
 {
@@ -66,6 +74,7 @@ public:
 	CDrodBitmapManager();
 	virtual ~CDrodBitmapManager();
 	
+	void        ClearStyleImageCache();
 	static bool ConvertStyle(WSTRING& style);
 	inline void FreezeStyle(const bool bFlag=true) {this->bStyleIsFrozen = bFlag;}
 	virtual UINT GetCustomTileNo(const UINT wTileSet, UINT wX, UINT wY,
@@ -106,10 +115,17 @@ protected:
 private:
 	virtual bool   GetMappingIndexFromTileImageMap(const WCHAR *pszName,
 			list<UINT> &MappingIndex) const;
+	void           AddStyleImage(const WSTRING& wstrName, SDL_Surface *pSurface);
+	list<CACHEDSTYLEIMAGE>::iterator FindStyleImage(const WCHAR *wszName);
+	SDL_Surface*   GetStyleImageSurface(const WCHAR *wszName);
 	virtual bool   LoadTileImages(const WCHAR *pszName, CIDSet& styleTiles,
 			CIDSet *pLoadTileSet=NULL);
 	bool           LoadTexture(const UINT wI, const WSTRING& wstrFilename);
+	void           PrefetchStyleImages(const vector<WSTRING>& names);
 	static const UINT NUM_TILEIMAGESURFACES;
+
+	list<CACHEDSTYLEIMAGE> styleImageCache; //most recently used first
+	UINT dwStyleImageCacheBytes;
 };
 
 //Define global pointer to the one and only CDrodBitmapManager object.
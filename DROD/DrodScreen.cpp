@@ -1982,6 +1982,7 @@ MESSAGE_ID CDrodScreen::ImportFiles(
 					Base64::decode(CDbXML::info.headerInfo, wstr);
 					f.WriteGameProfileBuffer(wstr,false,false);
 				}
+				g_pTheDBM->ClearStyleImageCache(); //imported images may replace cached ones
 				break;
 			case CImportInfo::Demo: dwImportedID = 1; break;   //value not used -- indicates a demo was in fact imported
 			default: dwImportedID = 0; break;  //value not important
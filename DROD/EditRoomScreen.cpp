@@ -1304,8 +1304,8 @@ void CEditRoomScreen::ClearList(
 //Params:
 	UndoList& List)
 {
-	for (UndoList::iterator vec=List.begin(); vec!=List.end(); ++vec)
-		for (vector<CDbBase*>::iterator iter = vec->begin(); iter != vec->end(); ++iter)
+	for (UndoList::iterator step=List.begin(); step!=List.end(); ++step)
+		for (vector<CDbBase*>::iterator iter = step->states.begin(); iter != step->states.end(); ++iter)
 			delete *iter;
 	List.clear();
 }
@@ -6562,7 +6562,7 @@ void CEditRoomScreen::RepairYellowDoors(const UINT doorType)
 void CEditRoomScreen::RemoveChange()
 //Removes last hold+room state from the undo stack.
 {
-	vector<CDbBase*> lastChange = this->undoList.back();
+	vector<CDbBase*>& lastChange = this->undoList.back().states;
 	for (vector<CDbBase*>::iterator change = lastChange.begin();
 			change != lastChange.end(); ++change)
 		delete *change;
@@ -6767,17 +6767,21 @@ void CEditRoomScreen::Changing(
 		this->nUndoSize = -1;   //now impossible to revert to clean state
 
 	//Save room state.
-	vector<CDbBase*> changes;
+	//Hold states leave out the custom characters.  They are copied only if they
+	//are about to be edited (see CharactersChanging).
+	UndoStep changes;
 	switch (eChange)
 	{
 		case RoomAndHold:
-			changes.push_back(new CDbHold(*(this->pHold)));
+			changes.states.push_back(new CDbHold(*(this->pHold), false));
+			changes.bHoldSharesCharacters = true;
 			//NO BREAK
 		case Room:
-			changes.push_back(new CDbRoom(*(this->pRoom), true, true));
+			changes.states.push_back(new CDbRoom(*(this->pRoom), true, true));
 		break;
 		case Hold:
-			changes.push_back(new CDbHold(*(this->pHold)));
+			changes.states.push_back(new CDbHold(*(this->pHold), false));
+			changes.bHoldSharesCharacters = true;
 		break;
 		default: ASSERT(!"Unrecognized Change enum"); break;
 	}
@@ -6790,6 +6794,33 @@ void CEditRoomScreen::Changing(
 	SetButtons();
 }
 
+//*****************************************************************************
+void CEditRoomScreen::CharactersChanging()
+//Call before the hold's custom characters are edited.
+//If the latest hold state saved for undo left the characters out, they are
+//copied into it now, while still unchanged.
+{
+	for (UndoList::reverse_iterator step = this->undoList.rbegin();
+			step != this->undoList.rend(); ++step)
+	{
+		for (vector<CDbBase*>::const_iterator state = step->states.begin();
+				state != step->states.end(); ++state)
+		{
+			CDbHold *pSavedHold = dynamic_cast<CDbHold*>(*state);
+			if (!pSavedHold)
+				continue;
+
+			if (step->bHoldSharesCharacters)
+			{
+				ASSERT(pSavedHold->characters.empty());
+				pSavedHold->CopyCharacters(*this->pHold);
+				step->bHoldSharesCharacters = false;
+			}
+			return;
+		}
+	}
+}
+
 //*****************************************************************************
 void CEditRoomScreen::RotateClockwise()
 //Set item orientation or obstacle type for placement.
@@ -7895,40 +7926,40 @@ void CEditRoomScreen::UndoCommand(
 //Params:
 	const bool bUndo) //true = undo; false = redo
 {
-	vector<CDbBase*> baseGet, baseSave;
+	UndoStep baseGet, baseSave;
 
 	if (!this->pCharacterDialog->IsCommandFinished())
 		return;
 
 	//Pop the last saved state.
-	if (bUndo)
-	{
-		if (this->undoList.empty())
-			return;
-		baseGet = this->undoList.back();
-		this->undoList.pop_back();
-	} else {
-		if (this->redoList.empty())
-			return;
-		baseGet = this->redoList.back();
-		this->redoList.pop_back();
-	}
+	UndoList& getList = bUndo ? this->undoList : this->redoList;
+	if (getList.empty())
+		return;
+	baseGet = getList.back();
+	getList.pop_back();
 
 	//Determine data types retrieved.
-	for (vector<CDbBase*>::iterator dbtype = baseGet.begin();
-			dbtype != baseGet.end(); ++dbtype)
+	for (vector<CDbBase*>::iterator dbtype = baseGet.states.begin();
+			dbtype != baseGet.states.end(); ++dbtype)
 	{
 		CDbBase *pBaseGet = *dbtype;
 		if (dynamic_cast<CDbRoom*>(pBaseGet))
 		{
-			baseSave.push_back(this->pRoom);
+			baseSave.states.push_back(this->pRoom);
 			this->pRoom = DYN_CAST(CDbRoom*, CDbBase*, pBaseGet);
 			this->pRoom->InitCoveredTiles();
 			this->pMapWidget->DrawMapSurfaceFromRoom(this->pRoom);
 			this->pMapWidget->RequestPaint();
 		} else if (dynamic_cast<CDbHold*>(pBaseGet)) {
-			baseSave.push_back(this->pHold);
-			this->pHold = DYN_CAST(CDbHold*, CDbBase*, pBaseGet);
+			CDbHold *pSavedHold = DYN_CAST(CDbHold*, CDbBase*, pBaseGet);
+			if (baseGet.bHoldSharesCharacters)
+			{
+				//The active hold's characters are the ones the saved state had.
+				pSavedHold->characters.swap(this->pHold->characters);
+				baseSave.bHoldSharesCharacters = true;
+			}
+			baseSave.states.push_back(this->pHold);
+			this->pHold = pSavedHold;
 
 			//Main level entrance might have changed rooms.
 			SetSignTextToCurrentRoom(this->pHold->GetMainEntranceRoomIDForLevel(
@@ -42,7 +42,17 @@ enum PlotType
 	PLOT_ERROR     //neither a head nor tail was plotted
 };
 
-typedef list<vector<CDbBase*> > UndoList;
+//One undo/redo step: the hold and/or room states saved before a change.
+struct UndoStep
+{
+	UndoStep() : bHoldSharesCharacters(false) {}
+
+	vector<CDbBase*> states;
+	bool bHoldSharesCharacters; //the saved hold has no copy of its custom characters,
+	                            //as they are the same as the following state's; they
+	                            //are taken from the active hold when this step is restored
+};
+typedef list<UndoStep> UndoList;
 
 class CCharacterDialogWidget;
 class CDbLevel;
@@ -89,6 +99,7 @@ private:
 	void     ApplyPlayerSettings();
 
 	void     Changing(const Change eChange=Room);
+	void     CharactersChanging();
 	static void    ClearList(UndoList& List);
 	void     ClickRoom();
 	const UINT*    DisplaySelection(const UINT wObjectNo) const;
@@ -1251,6 +1251,12 @@ void CGameScreen::OnBetweenEvents()
 				g_pTheSound->PlaySoundEffect(SEID_THUNDER, NULL, NULL, false, 1.0f + fRAND_MID(0.2f));
 			}
 		}
+
+		//While the player is idle, load a neighboring room so a room exit
+		//doesn't have to wait for it.
+		if (GetScreenType() == SCR_Game && this->pCurrentGame->bIsGameActive &&
+				!this->pCurrentGame->IsCutScenePlaying())
+			this->pCurrentGame->PrefetchAdjacentRoom();
 	}
 
 	CRoomScreen::OnBetweenEvents();
@@ -29,6 +29,7 @@
 
 #include "HoldSelectScreen.h"
 #include "BrowserScreen.h"
+#include "DrodBitmapManager.h"
 #include "DrodFontManager.h"
 #include "EditSelectScreen.h"
 #include "GameScreen.h"
@@ -800,6 +801,8 @@ void CHoldSelectScreen::DownloadNewRoomStyles(set<WSTRING>& importedStyles)
 		CDbXML::SetCallback(this);
 		MESSAGE_ID result = CDbXML::ImportXML(*pResults->pBuffer, CImportInfo::Data);
 		if (ImportConfirm(result)) {
+			g_pTheDBM->ClearStyleImageCache(); //imported images may replace cached ones
+
 			// Write the header info to the INI
 			WSTRING wstr;
 			Base64::decode(CDbXML::info.headerInfo, wstr);
@@ -40,6 +40,8 @@
 #include <BackEndLib/Assert.h>
 #include <BackEndLib/Files.h>
 
+#include <algorithm>
+
 //Map color indexes.
 enum MapColor
 {
@@ -200,12 +202,13 @@ void CMapWidget::GetVisibleMapRect(SDL_Rect &rect) const
 {
 	//Get bounds of explored rooms in level.
 	bool bFirstRoom = true;
-	list<CDbRoom *>::const_iterator iSeek;
 	CIDSet roomIDs = CDb::getRoomsInLevel(this->pLevel->dwLevelID);
 	UINT dwLeft=0, dwRight=0, dwTop=0, dwBottom=0;
 	for (CIDSet::const_iterator iter=roomIDs.begin(); iter != roomIDs.end(); ++iter)
 	{
-		CDbRoom *pRoom = g_pTheDB->Rooms.GetByID(*iter, true);  //load only coord data
+		const RoomMapTiles *pRoom = g_pTheDB->Rooms.GetMapTiles(*iter, false);  //only coord data
+		if (!pRoom)
+			continue;
 		const bool bIncludeRoom = this->bEditing ||
 				this->DarkenedRooms.has(*iter) ||
 				this->pCurrentGame->IsRoomAtCoordsExplored(pRoom->dwRoomX, pRoom->dwRoomY);
@@ -229,7 +232,6 @@ void CMapWidget::GetVisibleMapRect(SDL_Rect &rect) const
 					dwBottom = pRoom->dwRoomY;
 			}
 		}
-		delete pRoom;
 	}
 
 	rect.x = (Sint16)(this->wBorderW - 1 + (CDrodBitmapManager::DISPLAY_COLS * (dwLeft - this->dwLeftRoomX)));
@@ -434,11 +436,10 @@ bool CMapWidget::LoadFromLevel(
 	CIDSet roomIDs = CDb::getRoomsInLevel(this->pLevel->dwLevelID);
 	for (CIDSet::const_iterator room = roomIDs.begin(); room != roomIDs.end(); ++room)
 	{
-		CDbRoom *pRoom = g_pTheDB->Rooms.GetByID(*room, true);
+		const RoomMapTiles *pRoom = g_pTheDB->Rooms.GetMapTiles(*room, false);
 		if (pRoom)
 		{
 			SelectRoom(pRoom->dwRoomX, pRoom->dwRoomY);
-			delete pRoom;
 			break;
 		}
 	}
@@ -1006,13 +1007,15 @@ bool CMapWidget::LoadMapSurface(
 		return true;
 	}
 
-	//Load every room in the current level.
+	//Get map data for every room in the current level.
+	//Tiles are only decoded for rooms that will be drawn.
 	bool bFirstRoom = true;
-	list<CDbRoom *> DrawRooms;
-	list<CDbRoom *>::const_iterator iSeek;
+	vector<UINT> DrawRoomIDs;
 	for (CIDSet::const_iterator iter=roomIDs.begin(); iter != roomIDs.end(); ++iter)
 	{
-		CDbRoom *pRoom = g_pTheDB->Rooms.GetByID(*iter, true);  //load only coord data
+		const RoomMapTiles *pRoom = g_pTheDB->Rooms.GetMapTiles(*iter, false);  //only coord data
+		if (!pRoom)
+			continue;
 		const bool bIncludeRoom = this->bEditing ||
 				this->DarkenedRooms.has(*iter) ||
 				this->pCurrentGame->IsRoomAtCoordsExplored(pRoom->dwRoomX, pRoom->dwRoomY);
@@ -1037,14 +1040,9 @@ bool CMapWidget::LoadMapSurface(
 			}
 		}
 
-		if (!bIncludeRoom)
-			delete pRoom;
-		else
-		{
-			//Keep the rooms that have been explored in a list.
-			pRoom->LoadTiles();  //now load tile data
-			DrawRooms.push_back(pRoom);
-		}
+		//Keep the rooms that have been explored in a list.
+		if (bIncludeRoom)
+			DrawRoomIDs.push_back(*iter);
 	}
 
 	//Currently, a room's y-coordinate contains a pseudo-level encoding in its 100s place.
@@ -1094,7 +1092,6 @@ bool CMapWidget::LoadMapSurface(
 	}
 
 	//Create the surface
-	bool bSuccess = true;
 	this->pMapSurface = g_pTheBM->ConvertSurface(SDL_CreateRGBSurface(SDL_SWSURFACE, 
 			wMapW + (this->wBorderW * 2), wMapH + (this->wBorderH * 2),
 			g_pTheBM->BITS_PER_PIXEL, 0, 0, 0, 0));
@@ -1102,8 +1099,7 @@ bool CMapWidget::LoadMapSurface(
 	{
 		CFiles Files;
 		Files.AppendErrorLog("CMapWidget::LoadMapSurface()--SDL_CreateRGBSurface() failed.");
-		bSuccess = false;
-		goto Cleanup;
+		return false;
 	}
 	//Get colors for drawing on map surface.
 	InitMapColors();
@@ -1126,14 +1122,15 @@ bool CMapWidget::LoadMapSurface(
 #endif
 
 	//Draw each room onto the map.
-	for (iSeek = DrawRooms.begin(); iSeek != DrawRooms.end(); ++iSeek)
-		DrawMapSurfaceFromRoom(*iSeek);
-
-Cleanup:
-	for (iSeek = DrawRooms.begin(); iSeek != DrawRooms.end(); ++iSeek)
-		delete *iSeek;
+	for (vector<UINT>::const_iterator iSeek = DrawRoomIDs.begin();
+			iSeek != DrawRoomIDs.end(); ++iSeek)
+	{
+		const RoomMapTiles *pTiles = g_pTheDB->Rooms.GetMapTiles(*iSeek);
+		if (pTiles)
+			DrawMapSurfaceFromTiles(*pTiles);
+	}
 
-	return bSuccess;
+	return true;
 }
 
 //*****************************************************************************
@@ -1166,14 +1163,9 @@ void CMapWidget::UpdateMapSurface(const bool bRefreshSelectedRoom)	//[default=fa
 					bDrawCurrentRoom = true;
 				else
 				{
-					//Load the room in.
-					CDbRoom *pTempRoom = g_pTheDB->Rooms.GetByID(*iter, true);
-					if (pTempRoom)
-					{
-						pTempRoom->LoadTiles();
-						DrawMapSurfaceFromRoom(pTempRoom);
-						delete pTempRoom;
-					}
+					const RoomMapTiles *pTiles = g_pTheDB->Rooms.GetMapTiles(*iter);
+					if (pTiles)
+						DrawMapSurfaceFromTiles(*pTiles);
 					else
 						ASSERT(!"Failed to retrieve room");
 				}
@@ -1200,14 +1192,9 @@ void CMapWidget::UpdateMapSurface(const bool bRefreshSelectedRoom)	//[default=fa
 						bDrawCurrentRoom = true;
 					else
 					{
-						//Load the room in.
-						CDbRoom *pTempRoom = g_pTheDB->Rooms.GetByID(*iter, true);
-						if (pTempRoom)
-						{
-							pTempRoom->LoadTiles();
-							DrawMapSurfaceFromRoom(pTempRoom);
-							delete pTempRoom;
-						}
+						const RoomMapTiles *pTiles = g_pTheDB->Rooms.GetMapTiles(*iter);
+						if (pTiles)
+							DrawMapSurfaceFromTiles(*pTiles);
 						else
 							ASSERT(!"Failed to retrieve room");
 					}
@@ -1221,12 +1208,16 @@ void CMapWidget::UpdateMapSurface(const bool bRefreshSelectedRoom)	//[default=fa
 	//state the room was in when it was left.
 	if (bRefreshSelectedRoom)
 	{
-		CDbRoom *pSelectedRoom = g_pTheDB->Rooms.GetByCoords(
+		const UINT dwSelectedRoomID = CDbRooms::FindIDAtCoords(
 				this->dwLevelID, this->dwSelectedRoomX, this->dwSelectedRoomY);
-		if (pSelectedRoom)
+		const RoomMapTiles *pTiles = dwSelectedRoomID ?
+				g_pTheDB->Rooms.GetMapTiles(dwSelectedRoomID) : NULL;
+		if (pTiles)
 		{
-			DrawMapSurfaceFromRoom(pSelectedRoom);
-			delete pSelectedRoom;
+			//The room's original state may show a beacon not yet deactivated.
+			const bool bBeaconActive = std::find(pTiles->tTiles.begin(),
+					pTiles->tTiles.end(), (BYTE)T_BEACON) != pTiles->tTiles.end();
+			DrawMapSurfaceFromTiles(*pTiles, bBeaconActive);
 		}
 	}
 
@@ -1245,7 +1236,7 @@ void CMapWidget::UpdateMapSurface(const bool bRefreshSelectedRoom)	//[default=fa
 
 //*****************************************************************************
 void CMapWidget::DrawMapSurfaceFromRoom(
-//Loads a room from disk into a specified position in the map surface.
+//Draws a room into its position in the map surface.
 //
 //Params:
   const CDbRoom *pRoom) //(in)   Contains coords of room to update on map
@@ -1254,22 +1245,38 @@ void CMapWidget::DrawMapSurfaceFromRoom(
 {
 	ASSERT(pRoom);
 
+	RoomMapTiles tiles;
+	tiles.Set(*pRoom);
+	DrawMapSurfaceFromTiles(tiles, pRoom->IsBeaconActive());
+}
+
+//*****************************************************************************
+void CMapWidget::DrawMapSurfaceFromTiles(
+//Draws a room's map data into its position in the map surface.
+//
+//Params:
+	const RoomMapTiles& tiles, //(in) coords and squares of room to update on map
+	const bool bBeaconActive)  //(in) [default=false] whether the room has an
+	                           //active beacon, which applies to the current room
+{
+	ASSERT(tiles.HasTiles());
+
 	const bool bRoomIsCurrentRoom = this->pCurrentGame &&
-			pRoom->dwRoomID == this->pCurrentGame->pRoom->dwRoomID;
+			tiles.dwRoomID == this->pCurrentGame->pRoom->dwRoomID;
 
 	//Get variables that affect how map pixels are set.
-	const bool bRoomRequired = pRoom->bIsRequired;
-	const bool bRoomSecret = pRoom->bIsSecret;
+	const bool bRoomRequired = tiles.bIsRequired;
+	const bool bRoomSecret = tiles.bIsSecret;
 	bool bConquered, bPendingConquer, bDarkened;
 
 	//When there is no current game, then show everything fully.
 	if (this->pCurrentGame) {
-		if (bRoomIsCurrentRoom && pRoom->IsBeaconActive()) {
+		if (bRoomIsCurrentRoom && bBeaconActive) {
 			bConquered = false;
 		} else {
-			bConquered = this->pCurrentGame->IsRoomAtCoordsConquered(pRoom->dwRoomX, pRoom->dwRoomY);
+			bConquered = this->pCurrentGame->IsRoomAtCoordsConquered(tiles.dwRoomX, tiles.dwRoomY);
 		}
-		bDarkened = this->DarkenedRooms.has(pRoom->dwRoomID);
+		bDarkened = this->DarkenedRooms.has(tiles.dwRoomID);
 		bPendingConquer = bRoomIsCurrentRoom &&
 			this->pCurrentGame->IsCurrentRoomPendingConquer();
 	} else {
@@ -1284,7 +1291,7 @@ void CMapWidget::DrawMapSurfaceFromRoom(
 	static const UINT wBPP = this->pMapSurface->format->BytesPerPixel;
 	ASSERT(wBPP >= 3);
 	const UINT dwRowOffset = this->pMapSurface->pitch - (CDrodBitmapManager::DISPLAY_COLS * wBPP);
-	Uint8 *pSeek = GetRoomStart(pRoom->dwRoomX, pRoom->dwRoomY);
+	Uint8 *pSeek = GetRoomStart(tiles.dwRoomX, tiles.dwRoomY);
 #if (GAME_BYTEORDER == GAME_BYTEORDER_BIG)
 	ASSERT(this->pMapSurface->format->Rmask == 0xff0000);
 	ASSERT(this->pMapSurface->format->Gmask == 0x00ff00);
@@ -1306,8 +1313,7 @@ void CMapWidget::DrawMapSurfaceFromRoom(
 		while (pSeek != pEndOfRow)
 		{
 			Color = GetMapColorFromTile(
-				(unsigned char) pRoom->pszOSquares[wSquareIndex],
-				(unsigned char) pRoom->GetTSquare(wSquareIndex),
+				tiles.oTiles[wSquareIndex], tiles.tTiles[wSquareIndex],
 				bConquered, bDarkened, bPendingConquer, bRoomRequired, bRoomSecret);
 			pSeek[0] = Color.byt1;
 			pSeek[1] = Color.byt2;
@@ -30,6 +30,7 @@
 #include "DrodWidget.h"
 #include "../DRODLib/CurrentGame.h"
 #include "../DRODLib/DbHolds.h"
+#include "../DRODLib/DbRooms.h"
 #include "../DRODLib/ImportInfo.h"
 
 //******************************************************************************
@@ -43,6 +44,8 @@ public:
 	void           ClearState();
 	void           CopyRoom(const bool bCopy);
 	void           DrawMapSurfaceFromRoom(const CDbRoom *pRoom);
+	void           DrawMapSurfaceFromTiles(const RoomMapTiles& tiles,
+			const bool bBeaconActive=false);
 	SDL_Surface*   GetMapSurface() const {return this->pMapSurface;}
 	void           GetSelectedRoomXY(UINT &dwRoomX, UINT &dwRoomY) const;
 	void           GetSelectedRoomRect(SDL_Rect &rect) const;
@@ -27,6 +27,7 @@
 #include "ModScreen.h"
 #include "BrowserScreen.h"
 #include "EditSelectScreen.h"
+#include "DrodBitmapManager.h"
 #include "DrodFontManager.h"
 #include "GameScreen.h"
 
@@ -407,6 +408,7 @@ void CModScreen::DeleteSelectedMods()
 		styleName = UnicodeToAscii(wModName.c_str());
 		f.DeleteINIEntry(INISection::Graphics, styleName.c_str(), NULL);
 	}
+	g_pTheDBM->ClearStyleImageCache(); //don't show deleted images
 
 	PopulateModListBox();
 	SetDesc();
@@ -488,6 +490,7 @@ void CModScreen::DownloadSelectedMods()
 		CDbXML::SetCallback(this);
 		result = CDbXML::ImportXML(*pBuffer->pBuffer, CImportInfo::Data);
 		if (!ImportConfirm(result)) {delete pBuffer; HideStatusMessage(); SetCursor(); continue;}
+		g_pTheDBM->ClearStyleImageCache(); //imported images may replace cached ones
 
 		// Write the header info to the INI
 		WSTRING wstr;
@@ -313,6 +313,7 @@ CRoomWidget::CRoomWidget(
 	, pTileImages(NULL)
 	, bLastVision(false)
 	, pActiveLightedTiles(NULL)
+	, pLightBeingCached(NULL), wLightCacheDark(0)
 	, bRenderRoom(false), bRenderRoomLight(false), bRenderPlayerLight(false)
 	, wLastPlayerLightX(UINT(-1)), wLastPlayerLightY(UINT(-1))
 
@@ -1341,6 +1342,7 @@ void CRoomWidget::ClearLights()
 	this->lightedPlayerTiles.clear();
 	this->lightedRoomTiles.clear();
 	this->partialLightedTiles.clear();
+	this->roomLightCache.clear();
 
 	this->tileLightInfo.Init(this->pRoom->wRoomCols, this->pRoom->wRoomRows);
 
@@ -8608,14 +8610,24 @@ AddLightToSubtile:
 				bSomeLight ? (bSomeDark ? L_Partial : L_Light) :  //Was there some shadow here?
 					L_Dark; //There was no light here.
 
-		if (tileLightType == L_Partial || tileLightType == L_PartialItem)
-			this->partialLightedTiles.insert(wX,wY); //blur light edge here
+		if (this->pLightBeingCached)
+		{
+			//Recorded for ApplyCachedRoomLight.
+			if (tileLightType == L_Partial || tileLightType == L_PartialItem)
+				this->pLightBeingCached->partialTiles.push_back(ROOMCOORD(wX,wY));
+			if (fElev <= 0.0f)
+				this->pLightBeingCached->tileLightTypes.push_back(
+						make_pair(ROOMCOORD(wX,wY), UINT(tileLightType)));
+		} else {
+			if (tileLightType == L_Partial || tileLightType == L_PartialItem)
+				this->partialLightedTiles.insert(wX,wY); //blur light edge here
 
-		//Set to the max value applied to this tile this frame
-		//if the light is not on a wall or other elevated tile.
-		//This is to facilitate light blurring when shadows cross floor-level tiles.
-		if (fElev <= 0.0f && this->tileLightInfo.GetAt(wX,wY) < tileLightType)
-			this->tileLightInfo.Set(wX,wY,tileLightType);
+			//Set to the max value applied to this tile this frame
+			//if the light is not on a wall or other elevated tile.
+			//This is to facilitate light blurring when shadows cross floor-level tiles.
+			if (fElev <= 0.0f && this->tileLightInfo.GetAt(wX,wY) < tileLightType)
+				this->tileLightInfo.Set(wX,wY,tileLightType);
+		}
 	}
 
 	this->pActiveLightedTiles->insert(wX,wY);
@@ -9026,6 +9038,136 @@ void CRoomWidget::PropagateLightNoModel(const int nSX, const int nSY, const UINT
 			CastLightOnTile(nSX + nXdist, nSY + nYdist, light, false);
 }
 
+//*****************************************************************************
+void CRoomWidget::PropagateRoomLight(
+//Adds a room light source's light to the active light buffer.
+//
+//Casting light is expensive, so each light's contribution is kept and
+//reapplied on later renders as long as the room geometry within its reach,
+//the light's value and the room darkness remain the same.
+//
+//Params:
+	const UINT wX, const UINT wY, //(in) light source tile
+	const UINT lightValue,        //(in) light's tParam, or tile light value for wall lights
+	const bool bWallLight)        //(in) whether light is cast without a room model
+{
+	if (bLightOff(lightValue))
+		return; //light is off
+
+	const UINT key = this->pRoom->ARRAYINDEX(wX,wY) * 2 + (bWallLight ? 1 : 0);
+	GetLightFootprint(wX, wY, lightValue, this->lightFootprint);
+	CachedRoomLight& light = this->roomLightCache[key];
+	if (!light.bUsed && !light.tiles.empty() &&
+			light.lightValue == lightValue && light.footprint == this->lightFootprint)
+	{
+		light.bUsed = true;
+		ApplyCachedRoomLight(light);
+		return;
+	}
+
+	//Cast the light into a scratch buffer, recording where it shines.
+	light = CachedRoomLight();
+	light.lightValue = lightValue;
+	light.footprint.swap(this->lightFootprint);
+	light.bUsed = true;
+
+	const UINT bufferSize = this->lightMaps.bufferSize;
+	if (this->lightCacheBuffer.size() != bufferSize)
+		this->lightCacheBuffer.assign(bufferSize, 0);
+
+	LIGHTTYPE *pActiveLight = this->lightMaps.pActiveLight;
+	CCoordSet *pActiveLightedTiles = this->pActiveLightedTiles;
+	CCoordSet litTiles;
+	this->lightMaps.pActiveLight = &this->lightCacheBuffer[0];
+	this->pActiveLightedTiles = &litTiles;
+	this->pLightBeingCached = &light;
+
+	if (bWallLight)
+		PropagateLightNoModel(wX, wY, lightValue);
+	else
+		PropagateLight(float(wX), float(wY), lightValue);
+
+	this->pLightBeingCached = NULL;
+	this->lightMaps.pActiveLight = pActiveLight;
+	this->pActiveLightedTiles = pActiveLightedTiles;
+
+	//Move the light values out of the scratch buffer.
+	light.tiles.reserve(litTiles.size());
+	light.light.reserve(litTiles.size() * wLightValuesPerTile);
+	for (CCoordSet::const_iterator tile = litTiles.begin(); tile != litTiles.end(); ++tile)
+	{
+		LIGHTTYPE *pSrc = &this->lightCacheBuffer[0] +
+				this->pRoom->ARRAYINDEX(tile->wX,tile->wY) * wLightValuesPerTile;
+		light.tiles.push_back(*tile);
+		light.light.insert(light.light.end(), pSrc, pSrc + wLightValuesPerTile);
+		memset(pSrc, 0, wLightBytesPerTile);
+	}
+
+	ApplyCachedRoomLight(light);
+}
+
+//*****************************************************************************
+void CRoomWidget::ApplyCachedRoomLight(const CachedRoomLight& light)
+//Adds a room light's recorded contribution to the active light buffer.
+{
+	const vector<LIGHTTYPE>::const_iterator lightEnd = light.light.end();
+	vector<LIGHTTYPE>::const_iterator pSrc = light.light.begin();
+	for (vector<ROOMCOORD>::const_iterator tile = light.tiles.begin();
+			tile != light.tiles.end(); ++tile)
+	{
+		const UINT wIndex = this->pRoom->ARRAYINDEX(tile->wX,tile->wY);
+		LIGHTTYPE *pDest = this->lightMaps.pActiveLight + wIndex * wLightValuesPerTile;
+		for (UINT i = 0; i < wLightValuesPerTile; ++i, ++pSrc, ++pDest)
+		{
+			const UINT val = *pDest + *pSrc;
+			*pDest = val < LIGHTTYPE(-1) ? val : LIGHTTYPE(-1);
+		}
+
+		this->pActiveLightedTiles->insert(tile->wX,tile->wY);
+		this->pTileImages[wIndex].dirty = 1;
+	}
+	ASSERT(pSrc == lightEnd);
+
+	for (vector<ROOMCOORD>::const_iterator tile = light.partialTiles.begin();
+			tile != light.partialTiles.end(); ++tile)
+		this->partialLightedTiles.insert(tile->wX,tile->wY); //blur light edge here
+
+	for (vector<pair<ROOMCOORD, UINT> >::const_iterator tile = light.tileLightTypes.begin();
+			tile != light.tileLightTypes.end(); ++tile)
+	{
+		const ROOMCOORD& coord = tile->first;
+		if (this->tileLightInfo.GetAt(coord.wX,coord.wY) < tile->second)
+			this->tileLightInfo.Set(coord.wX,coord.wY,tile->second);
+	}
+}
+
+//*****************************************************************************
+void CRoomWidget::GetLightFootprint(
+//Outputs everything in the room that affects how a light casts, over the area
+//it can reach plus a margin for wall shape calculations.
+//
+//Params:
+	const UINT wX, const UINT wY, const UINT lightValue, //(in) light
+	vector<UINT>& footprint) //(out) three values per square in reach
+const
+{
+	const int nReach = 1 + calcLightRadius(lightValue) + 2;
+	const int nMinX = max(0, int(wX) - nReach);
+	const int nMinY = max(0, int(wY) - nReach);
+	const int nMaxX = min(int(this->pRoom->wRoomCols) - 1, int(wX) + nReach);
+	const int nMaxY = min(int(this->pRoom->wRoomRows) - 1, int(wY) + nReach);
+
+	footprint.clear();
+	for (int nY = nMinY; nY <= nMaxY; ++nY)
+		for (int nX = nMinX; nX <= nMaxX; ++nX)
+		{
+			const UINT wTTile = this->pRoom->GetTSquare(nX, nY);
+			footprint.push_back(this->pRoom->GetOSquare(nX, nY));
+			footprint.push_back(wTTile == T_ORB || wTTile == T_BOMB ? wTTile : 0);
+			footprint.push_back(this->pRoom->tileLights.GetAt(nX, nY));
+		}
+}
+
 //*****************************************************************************
 void CRoomWidget::ReduceJitter()
 //Reduce the amount of jitter on each tile every so often
@@ -9432,6 +9574,16 @@ bool CRoomWidget::UpdateDrawSquareInfo(
 
 		this->lightMaps.pActiveLight = this->lightMaps.psRoomLight; //write to room light buffer
 		this->pActiveLightedTiles = &this->lightedRoomTiles;
+
+		//Cached light contributions are only valid for the darkness they were cast in.
+		if (this->wLightCacheDark != this->wDark)
+		{
+			this->roomLightCache.clear();
+			this->wLightCacheDark = this->wDark;
+		}
+		for (std::map<UINT, CachedRoomLight>::iterator light = this->roomLightCache.begin();
+				light != this->roomLightCache.end(); ++light)
+			light->second.bUsed = false;
 	}
 
 	wIndex = 0;
@@ -9620,23 +9772,6 @@ bool CRoomWidget::UpdateDrawSquareInfo(
 			if (tTile == T_OBSTACLE && !this->wDark)	//no shadows in dark rooms
 				AddObstacleShadowMask(wCol,wRow);
 
-			//Light sources.
-			//T-layer lights and wall lights are handled here.
-			if (bRenderLights)
-			{
-				if (tTile == T_BEACON) {
-					static const UINT wBeaconLightRadius = 2;
-					static const UINT wLightParam = (wBeaconLightRadius-1)*NUM_LIGHT_TYPES + 4; //light red
-					PropagateLight(float(wCol), float(wRow), wLightParam);
-				}
-				if (bIsLight(tTile))
-					PropagateLight(float(wCol), float(wRow), this->pRoom->GetTParam(wCol, wRow));
-
-				wLightVal = this->pRoom->tileLights.GetAt(wCol, wRow);
-				if (bIsWallLightValue(wLightVal))
-					PropagateLightNoModel(wCol, wRow, wLightVal);
-			}
-
 			//Monster tiles might change, but most of these are taken care of
 			//in DirtySpriteTiles() as they move.  Cases not taken care of
 			//are (1) when a monster is killed without an effect to dirty its tile,
@@ -9659,6 +9794,40 @@ bool CRoomWidget::UpdateDrawSquareInfo(
 
 	if (bRenderLights)
 	{
+		//Light sources.
+		//T-layer lights and wall lights are handled here, once all tile images
+		//used in modelling the room are current.
+		pucT = this->pRoom->tLayer;
+		for (UINT wRow = 0; wRow < wRows; ++wRow)
+		{
+			for (UINT wCol = 0; wCol < wCols; ++wCol, ++pucT)
+			{
+				const RoomObject *tObj = *pucT;
+				const UINT tTile = tObj ? tObj->tile : RoomObject::emptyTile();
+				if (tTile == T_BEACON) {
+					static const UINT wBeaconLightRadius = 2;
+					static const UINT wLightParam = (wBeaconLightRadius-1)*NUM_LIGHT_TYPES + 4; //light red
+					PropagateRoomLight(wCol, wRow, wLightParam, false);
+				}
+				if (bIsLight(tTile))
+					PropagateRoomLight(wCol, wRow, this->pRoom->GetTParam(wCol, wRow), false);
+
+				wLightVal = this->pRoom->tileLights.GetAt(wCol, wRow);
+				if (bIsWallLightValue(wLightVal))
+					PropagateRoomLight(wCol, wRow, wLightVal, true);
+			}
+		}
+
+		//Forget lights that are no longer in the room.
+		for (std::map<UINT, CachedRoomLight>::iterator light = this->roomLightCache.begin();
+				light != this->roomLightCache.end(); )
+		{
+			if (light->second.bUsed)
+				++light;
+			else
+				this->roomLightCache.erase(light++);
+		}
+
 		//Done rendering room lighting.  Prepare for display.
 		ProcessLightmap();
 		this->bRenderPlayerLight = IsPlayerLightRendered(); //add player light to room display also
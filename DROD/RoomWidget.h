@@ -85,6 +85,21 @@ struct EDGES {
 
 typedef USHORT LIGHTTYPE; //used to used a light value
 
+//One room light's contribution to the room light buffer.
+//Reapplied instead of recast while the room around the light is unchanged.
+struct CachedRoomLight
+{
+	CachedRoomLight() : lightValue(0), bUsed(false) {}
+
+	UINT lightValue;        //light's tParam or tile light value
+	vector<UINT> footprint; //room geometry the light can reach, when it was cast
+	vector<ROOMCOORD> tiles;          //tiles with light cast onto them
+	vector<LIGHTTYPE> light;          //light values for each tile in 'tiles'
+	vector<ROOMCOORD> partialTiles;   //tiles with some light and shadow on them
+	vector<pair<ROOMCOORD, UINT> > tileLightTypes; //lighting property applied to floor tiles
+	bool bUsed;             //light was applied during the current room light render
+};
+
 struct TileImages
 {
 	UINT o, f, t, tCovered, wallShadow;
@@ -516,6 +531,11 @@ protected:
 	CCoordSet           *pActiveLightedTiles;//tiles being marked with light
 	CCoordSet            partialLightedTiles;//tiles with some light and shadow on them
 	CCoordIndex          tileLightInfo;      //property of lighting applied to each tile
+	std::map<UINT, CachedRoomLight> roomLightCache; //room lights' contributions, by tile and light kind
+	CachedRoomLight     *pLightBeingCached;  //room light whose contribution is being recorded
+	vector<LIGHTTYPE>    lightCacheBuffer;   //scratch light buffer for recording a room light
+	vector<UINT>         lightFootprint;     //scratch footprint of the room light being propagated
+	UINT                 wLightCacheDark;    //room darkness the cached lights were cast in
 	CCoordIndex          jitterInfo;         //how much jitter applied to the sprite on each tile
 	bool                 bRenderRoom;        //flag indicates room must be re-rendered
 	bool                 bRenderRoomLight;   //flag indicates room lighting must be re-rendered
@@ -629,6 +649,11 @@ private:
 	void           PropagateLight(const float fSX, const float fSY, const UINT tParam, const bool bCenterOnTile=true,
 			const Point& direction=Point(0.0f,0.0f,0.0f));
 	void           PropagateLightNoModel(const int nSX, const int nSY, const UINT tParam);
+	void           PropagateRoomLight(const UINT wX, const UINT wY, const UINT lightValue,
+			const bool bWallLight);
+	void           ApplyCachedRoomLight(const CachedRoomLight& light);
+	void           GetLightFootprint(const UINT wX, const UINT wY, const UINT lightValue,
+			vector<UINT>& footprint) const;
 
 	void           PlacePlayerLightAt(int pixel_x, int pixel_y);
 	void           PropagatePlayerLight();
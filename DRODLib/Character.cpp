@@ -864,6 +864,27 @@ bool CCharacter::IsValidFactor(const WCHAR *pwStr, UINT& index, CDbHold *pHold)
 	return false;
 }
 
+//*****************************************************************************
+int CCharacter::evalExpression(
+//Evaluates an expression using its compiled form, which is cached for the hold.
+//Expressions that don't compile are parsed directly so parse errors are reported.
+//
+//Returns: value of the expression
+//
+//Params:
+	const WSTRING& wstrExpression, //(in) expression text
+	CCurrentGame *pGame,           //(in) game whose vars are read
+	CCharacter *pNPC)              //(in) NPC evaluating the expression [default=NULL]
+{
+	ASSERT(pGame);
+	const CScriptExpression& expression = pGame->scriptExpressions.Get(wstrExpression, pGame->pHold);
+	if (expression.IsCompiled())
+		return expression.Evaluate(pGame, pNPC);
+
+	UINT index=0;
+	return parseExpression(wstrExpression.c_str(), index, pGame, pNPC);
+}
+
 //*****************************************************************************
 int CCharacter::parseExpression(
 //Parse and evaluate a simple nested expression for the grammar
@@ -1111,7 +1132,7 @@ void CCharacter::Process(
 
 	//Sword cache must be cleared to avoid using state of the room from some other entity's
 	//turn and/or being blocked by this character's own weapon
-	this->swordsInRoom.Clear();
+	GetPathSearchContext().swordsInRoom.Clear();
 
 	//Only character monsters taking up a single tile are implemented.
 	ASSERT(!bIsSerpentOrGentryii(GetResolvedIdentity()));
@@ -3096,7 +3117,7 @@ bool CCharacter::GetMovement(
 			const bool bGoalIsCurrent = this->goal.wX == wDestX && this->goal.wY == wDestY;
 			this->goal.wX = wDestX;
 			this->goal.wY = wDestY;
-			room.GetSwordCoords(this->swordsInRoom, true, false, this); //optimization
+			room.GetSwordCoords(GetPathSearchContext().swordsInRoom, true, false, this); //optimization
 			if (bGoalIsCurrent && ConfirmPathWithNextMoveOpen()) {
 				bPathmapping = true;
 			} else {
@@ -3133,9 +3154,10 @@ bool CCharacter::GetMovement(
 bool CCharacter::ConfirmPathWithNextMoveOpen()
 {
 	//Previously mapped path may go through specially marked NPCs...
-	CMonster::calculatingPathmap = true;
+	CPathSearchContext& context = GetPathSearchContext();
+	context.bCalculatingPathmap = true;
 	const bool bRes = ConfirmPath();
-	CMonster::calculatingPathmap = false;
+	context.bCalculatingPathmap = false;
 
 	//...as long as the step to take now is open.
 	if (bRes) {
@@ -3536,7 +3558,6 @@ bool CCharacter::DoesVarSatisfy(const CCharacterCommand& command, CCurrentGame *
 
 	//Get variable.
 	CDbPackedVars& stats = pGame->stats;
-	char holdVarName[11] = "v";
 	UNPACKEDVARTYPE vType = UVT_int;
 
 	const bool bPredefinedVar = varIndex >= UINT(ScriptVars::FirstPredefinedVar);
@@ -3551,13 +3572,8 @@ bool CCharacter::DoesVarSatisfy(const CCharacterCommand& command, CCurrentGame *
 		}
 		if (!bLocalVar)
 		{
-			//Get local hold var.
-			char varID[10];
-			_itoa(varIndex, varID, 10);
-			strcat(holdVarName, varID);
-
-			//Enforce basic type checking.
-			vType = stats.GetVarType(holdVarName);
+			//Get local hold var, enforcing basic type checking.
+			vType = stats.GetHoldVarType(varIndex);
 			bValidInt = vType == UVT_int || vType == UVT_uint || vType == UVT_unknown;
 		}
 	}
@@ -3566,8 +3582,7 @@ bool CCharacter::DoesVarSatisfy(const CCharacterCommand& command, CCurrentGame *
 	if (!operand && !command.label.empty() && command.y != ScriptVars::EqualsText)
 	{
 		//Operand is not just an integer, but a text expression.
-		UINT index=0;
-		operand = parseExpression(command.label.c_str(), index, pGame, this);
+		operand = evalExpression(command.label, pGame, this);
 	}
 
 	int x=0;
@@ -3578,7 +3593,7 @@ bool CCharacter::DoesVarSatisfy(const CCharacterCommand& command, CCurrentGame *
 		} else if (bLocalVar) {
 			x = getLocalVarInt(localVarName);
 		} else {
-			x = stats.GetVar(holdVarName, (int)0);
+			x = stats.GetHoldVarInt(varIndex);
 		}
 	}
 
@@ -3600,7 +3615,7 @@ bool CCharacter::DoesVarSatisfy(const CCharacterCommand& command, CCurrentGame *
 				wStr = getLocalVarString(localVarName);
 			} else {
 				if (vType == UVT_wchar_string)
-					wStr = stats.GetVar(holdVarName, wszEmpty);
+					wStr = stats.GetHoldVarText(varIndex, wszEmpty);
 			}
 			const WSTRING operand = pGame->ExpandText(command.label.c_str(), this);
 			return wStr == operand;
@@ -3619,7 +3634,6 @@ void CCharacter::SetVariable(const CCharacterCommand& command, CCurrentGame* pGa
 
 	//Get variable.
 	CDbPackedVars& stats = pGame->stats;
-	char varName[11] = "v";
 
 	const bool bPredefinedVar = varIndex >= UINT(ScriptVars::FirstPredefinedVar);
 	int predefinedVarVal = 0;
@@ -3641,13 +3655,8 @@ void CCharacter::SetVariable(const CCharacterCommand& command, CCurrentGame* pGa
 		}
 		if (!bLocalVar)
 		{
-			//Get local hold var.
-			char varID[10];
-			_itoa(varIndex, varID, 10);
-			strcat(varName, varID);
-
-			//Enforce basic type checking.
-			const UNPACKEDVARTYPE vType = stats.GetVarType(varName);
+			//Get local hold var, enforcing basic type checking.
+			const UNPACKEDVARTYPE vType = stats.GetHoldVarType(varIndex);
 			bValidInt = vType == UVT_int || vType == UVT_uint || vType == UVT_unknown;
 		}
 	}
@@ -3659,8 +3668,7 @@ void CCharacter::SetVariable(const CCharacterCommand& command, CCurrentGame* pGa
 	if (!operand && !command.label.empty() && bSetNumber)
 	{
 		//Operand is not just an integer, but a text expression.
-		UINT index=0;
-		operand = parseExpression(command.label.c_str(), index, pGame, this);
+		operand = evalExpression(command.label, pGame, this);
 	}
 
 	int x=0;
@@ -3672,28 +3680,28 @@ void CCharacter::SetVariable(const CCharacterCommand& command, CCurrentGame* pGa
 		break;
 		case ScriptVars::Inc:
 			if (bValidInt)
-				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetVar(varName, (int)0);
+				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetHoldVarInt(varIndex);
 			addWithClamp(x, operand);
 		break;
 		case ScriptVars::Dec:
 			if (bValidInt)
-				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetVar(varName, (int)0);
+				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetHoldVarInt(varIndex);
 			addWithClamp(x, -operand);
 		break;
 		case ScriptVars::MultiplyBy:
 			if (bValidInt)
-				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetVar(varName, (int)0);
+				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetHoldVarInt(varIndex);
 			multWithClamp(x, operand);
 		break;
 		case ScriptVars::DivideBy:
 			if (bValidInt)
-				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetVar(varName, (int)0);
+				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetHoldVarInt(varIndex);
 			if (operand)
 				x /= operand;
 		break;
 		case ScriptVars::Mod:
 			if (bValidInt)
-				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetVar(varName, (int)0);
+				x = bPredefinedVar ? predefinedVarVal : bLocalVar ? getLocalVarInt(localVarName) : stats.GetHoldVarInt(varIndex);
 			if (operand)
 				x = x % operand;
 		break;
@@ -3704,17 +3712,17 @@ void CCharacter::SetVariable(const CCharacterCommand& command, CCurrentGame* pGa
 			if (bLocalVar)
 				SetLocalVar(localVarName, text);
 			else
-				stats.SetVar(varName, text.c_str());
+				stats.SetHoldVar(varIndex, text.c_str());
 		}
 		break;
 		case ScriptVars::AppendText:
 		{
-			WSTRING text = bLocalVar ? getLocalVarString(localVarName) : stats.GetVar(varName, wszEmpty);
+			WSTRING text = bLocalVar ? getLocalVarString(localVarName) : stats.GetHoldVarText(varIndex, wszEmpty);
 			text += pGame->ExpandText(command.label.c_str(), this);
 			if (bLocalVar)
 				SetLocalVar(localVarName, text);
 			else
-				stats.SetVar(varName, text.c_str());
+				stats.SetHoldVar(varIndex, text.c_str());
 		}
 		break;
 		default: break;
@@ -3728,7 +3736,7 @@ void CCharacter::SetVariable(const CCharacterCommand& command, CCurrentGame* pGa
 			_itoW(int(x), wIntText, 10);
 			SetLocalVar(localVarName, wIntText);
 		} else {
-			stats.SetVar(varName, x);
+			stats.SetHoldVar(varIndex, x);
 		}
 	}
 }
@@ -4199,7 +4207,7 @@ const
 	//Check for monster at square.
 	CMonster *pMonster = room.GetMonsterAtSquare(wCol, wRow);
 	if (pMonster && pMonster->wType != M_FLUFFBABY) {
-		if (!CMonster::calculatingPathmap || pMonster->IsNPCPathmapObstacle()){
+		if (!GetPathSearchContext().bCalculatingPathmap || pMonster->IsNPCPathmapObstacle()){
 			const int dx = (int)wCol - (int)this->wX;
 			const int dy = (int)wRow - (int)this->wY;
 
@@ -4216,8 +4224,8 @@ const
 		return true;
 
 	//Can't step on any swords.
-	if (!this->swordsInRoom.empty()) {
-		if (this->swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
+	if (!GetPathSearchContext().swordsInRoom.empty()) {
+		if (GetPathSearchContext().swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
 			return true;
 	} else {
 		//Check for player's sword at square.
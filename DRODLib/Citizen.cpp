@@ -111,7 +111,7 @@ const
 		return true;
 
 	//Can't step on any swords.
-	if (this->swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
+	if (GetPathSearchContext().swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
 		return true;
 
 	//Player can never be stepped on.
@@ -218,7 +218,7 @@ bool CCitizen::CalcPathAndAdvance(CCueEvents& CueEvents)
 	if (!bGoalIsCurrent ||
 			nDist(this->wX, this->wY, this->goal.wX, this->goal.wY) != 1)
 	{
-		room.GetSwordCoords(this->swordsInRoom, true); //speed optimization
+		room.GetSwordCoords(GetPathSearchContext().swordsInRoom, true); //speed optimization
 		if (!bGoalIsCurrent || !ConfirmPath())
 		{
 			//If it's not, search for a (new) path to the goal.
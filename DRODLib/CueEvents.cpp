@@ -29,6 +29,8 @@
 #include "MonsterMessage.h"
 #include <BackEndLib/AttachableObject.h>
 
+#include <algorithm>
+
 using namespace std;
 
 //
@@ -69,6 +71,8 @@ const CUEEVENT_ID CIDA_MonsterStabbed[3] = {
 //Public methods.
 //
 
+#define NO_NODE (UINT(-1))
+
 //***************************************************************************************
 void CCueEvents::SetMembers(const CCueEvents& Src)
 //Sets members to value of other CCueEvents, but all data becomes unattached
@@ -77,69 +81,76 @@ void CCueEvents::SetMembers(const CCueEvents& Src)
 
 	//Copy all data
 
-	this->wEventCount = Src.wEventCount;
-	this->wNextPrivateDataIndex = Src.wNextPrivateDataIndex;
+	this->wNextNode = Src.wNextNode;
 	this->wNextCID = Src.wNextCID;
 
-	for (UINT wCID=CUEEVENT_COUNT; wCID--; )
+	this->firedCIDs = Src.firedCIDs;
+	for (vector<CUEEVENT_ID>::const_iterator cid = this->firedCIDs.begin();
+			cid != this->firedCIDs.end(); ++cid)
 	{
-		this->barrIsCIDSet[wCID] = Src.barrIsCIDSet[wCID];
-
-		vector<CID_PRIVDATA_NODE>::const_iterator pSeek = Src.CIDPrivateData[wCID].begin();
-		while (pSeek != Src.CIDPrivateData[wCID].end())
-		{
-			ASSERT(pSeek->pvPrivateData);
-
-			this->CIDPrivateData[wCID].push_back(CID_PRIVDATA_NODE(false, pSeek->pvPrivateData));
-			++pSeek;
-		}
+		this->barrIsCIDSet[*cid] = true;
+		this->CIDPrivateData[*cid] = Src.CIDPrivateData[*cid];
 	}
+
+	//Node indices are kept the same so the event lists above remain valid.
+	this->privateData = Src.privateData;
+	for (vector<CID_PRIVDATA_NODE>::iterator pNode = this->privateData.begin();
+			pNode != this->privateData.end(); ++pNode)
+		pNode->bIsAttached = false;
 }
 
 //***************************************************************************************
 void CCueEvents::Clear()
 //Frees resources and resets members.
 {
-	//Delete private data and nodes to track it.
-	for (UINT wCID=CUEEVENT_COUNT; wCID--; )
+	//Delete private data.
+	for (vector<CID_PRIVDATA_NODE>::const_iterator pNode = this->privateData.begin();
+			pNode != this->privateData.end(); ++pNode)
 	{
-		vector<CID_PRIVDATA_NODE>::iterator pSeek = this->CIDPrivateData[wCID].begin();
-		while (pSeek != this->CIDPrivateData[wCID].end())
-		{
-			ASSERT(pSeek->pvPrivateData);
-			if (pSeek->bIsAttached)
-				delete pSeek->pvPrivateData;
-			++pSeek;
-		}
-		//this->CIDPrivateData[wCID].clear();	//cleared in Zero below
+		if (pNode->bIsAttached)
+			delete pNode->pvPrivateData;
+	}
+	this->privateData.clear();
+
+	//Reset only the events that occurred.
+	for (vector<CUEEVENT_ID>::const_iterator cid = this->firedCIDs.begin();
+			cid != this->firedCIDs.end(); ++cid)
+	{
+		CID_PRIVDATA_LIST& list = this->CIDPrivateData[*cid];
+		list.wFirstNode = list.wLastNode = NO_NODE;
+		list.wCount = 0;
+		this->barrIsCIDSet[*cid] = false;
 	}
+	this->firedCIDs.clear();
 
-	//Zero all the members.
-	Zero();
+	this->wNextNode = NO_NODE;
+	this->wNextCID = (UINT)-1;
 }
 
 //***************************************************************************************
 void CCueEvents::ClearEvent(const CUEEVENT_ID eCID, const bool bDeleteAttached)	//[default=true]
 //Resets members for specified cue event.
 {
-	if (bDeleteAttached)
+	CID_PRIVDATA_LIST& list = this->CIDPrivateData[eCID];
+
+	//Detach the event's nodes.  They stay in the arena until the next Clear().
+	for (UINT wNode = list.wFirstNode; wNode != NO_NODE; )
 	{
-		//Delete attached data objects.
-		vector<CID_PRIVDATA_NODE>::iterator pSeek = this->CIDPrivateData[eCID].begin();
-		while (pSeek != this->CIDPrivateData[eCID].end())
-		{
-			ASSERT(pSeek->pvPrivateData);
-			if (pSeek->bIsAttached)
-				delete pSeek->pvPrivateData;
-			++pSeek;
-		}
+		CID_PRIVDATA_NODE& node = this->privateData[wNode];
+		ASSERT(node.pvPrivateData);
+		if (bDeleteAttached && node.bIsAttached)
+			delete node.pvPrivateData;
+		node.pvPrivateData = NULL;
+		node.bIsAttached = false;
+		wNode = node.wNextNode;
 	}
-	this->CIDPrivateData[eCID].clear();
+	list.wFirstNode = list.wLastNode = NO_NODE;
+	list.wCount = 0;
 
 	//Reset any iteration through this event's members.
 	if (this->wNextCID == (UINT)eCID)
 	{
-		this->wNextPrivateDataIndex = 0;
+		this->wNextNode = NO_NODE;
 		this->wNextCID = (UINT)-1;
 	}
 
@@ -147,7 +158,10 @@ void CCueEvents::ClearEvent(const CUEEVENT_ID eCID, const bool bDeleteAttached)
 	if (this->barrIsCIDSet[eCID])
 	{
 		this->barrIsCIDSet[eCID] = false;
-		--this->wEventCount;
+		vector<CUEEVENT_ID>::iterator cid = std::find(
+				this->firedCIDs.begin(), this->firedCIDs.end(), eCID);
+		ASSERT(cid != this->firedCIDs.end());
+		this->firedCIDs.erase(cid);
 	}
 }
 
@@ -162,7 +176,7 @@ UINT CCueEvents::GetOccurrenceCount(
 //The count.  Will be 0 if cue event has not occurred.
 const
 {
-	return this->CIDPrivateData[eCID].size();
+	return this->CIDPrivateData[eCID].wCount;
 }
 
 //***************************************************************************************
@@ -188,13 +202,27 @@ void CCueEvents::Add(
 	if (!this->barrIsCIDSet[eCID])
 	{
 		this->barrIsCIDSet[eCID] = true;
-		++this->wEventCount;
+		this->firedCIDs.push_back(eCID);
 	}
 
-	//Add private data.
+	//Add private data to the end of the event's list.
 	if (pvPrivateData)
-		this->CIDPrivateData[eCID].push_back(
-				CID_PRIVDATA_NODE(bIsAttached, pvPrivateData));
+	{
+		const UINT wNode = this->privateData.size();
+		this->privateData.push_back(CID_PRIVDATA_NODE(bIsAttached, pvPrivateData));
+
+		CID_PRIVDATA_LIST& list = this->CIDPrivateData[eCID];
+		if (list.wLastNode == NO_NODE)
+			list.wFirstNode = wNode;
+		else
+			this->privateData[list.wLastNode].wNextNode = wNode;
+		list.wLastNode = wNode;
+		++list.wCount;
+
+		//Continue an iteration that had reached the end of this event's data.
+		if (this->wNextCID == (UINT)eCID && this->wNextNode == NO_NODE)
+			this->wNextNode = wNode;
+	}
 }
 
 //***************************************************************************************
@@ -208,18 +236,19 @@ const CAttachableObject* CCueEvents::GetFirstPrivateData(
 //Returns:
 //First private data pointer or NULL if there is no private data associated with cue event.
 {
-	vector<CID_PRIVDATA_NODE>::const_iterator pFirst = this->CIDPrivateData[eCID].begin();
-	if (pFirst != this->CIDPrivateData[eCID].end())
+	const UINT wFirstNode = this->CIDPrivateData[eCID].wFirstNode;
+	if (wFirstNode != NO_NODE)
 	{
 		ASSERT(this->barrIsCIDSet[eCID]); //If I found private data then the event should be set.
-		ASSERT(pFirst->pvPrivateData);
+		const CID_PRIVDATA_NODE& first = this->privateData[wFirstNode];
+		ASSERT(first.pvPrivateData);
 
 		this->wNextCID = eCID;
-		this->wNextPrivateDataIndex = 1;
-		return pFirst->pvPrivateData;
+		this->wNextNode = first.wNextNode;
+		return first.pvPrivateData;
 	}
 
-	this->wNextPrivateDataIndex = 0;
+	this->wNextNode = NO_NODE;
 	this->wNextCID = (UINT)-1;
 	return NULL;
 }
@@ -234,13 +263,13 @@ const CAttachableObject* CCueEvents::GetNextPrivateData()
 {
 	//Check whether there are any more private data left.
 	if (this->wNextCID == (UINT)-1) return NULL;
-	if (this->wNextPrivateDataIndex >= this->CIDPrivateData[this->wNextCID].size())
+	if (this->wNextNode == NO_NODE)
 		return NULL;
 
-	CID_PRIVDATA_NODE *pCurrent = &(this->CIDPrivateData[this->wNextCID]
-			[this->wNextPrivateDataIndex++]);
-	ASSERT(pCurrent->pvPrivateData);
-	return pCurrent->pvPrivateData;
+	const CID_PRIVDATA_NODE& current = this->privateData[this->wNextNode];
+	this->wNextNode = current.wNextNode;
+	ASSERT(current.pvPrivateData);
+	return current.pvPrivateData;
 }
 
 //***************************************************************************************
@@ -255,6 +284,9 @@ bool CCueEvents::HasAnyOccurred(
 //True if any of the IDs were found, false if not.
 const
 {
+	if (this->firedCIDs.empty())
+		return false;
+
 	//Each iteration checks for presence of one CID from
 	for (UINT wCIDI = 0; wCIDI < wCIDArrayCount; ++wCIDI)
 	{
@@ -283,16 +315,14 @@ const
 	ASSERT(IS_VALID_CID(eCID));
 	ASSERT(pvPrivateData);
 
-	vector<CID_PRIVDATA_NODE>::const_iterator pSeek = this->CIDPrivateData[eCID].begin();
-	const vector<CID_PRIVDATA_NODE>::const_iterator pSeekEnd = this->CIDPrivateData[eCID].end();
-
 	//Each iteration checks on private data for a matching pointer.
-	while (pSeek != pSeekEnd)
+	for (UINT wNode = this->CIDPrivateData[eCID].wFirstNode; wNode != NO_NODE; )
 	{
 		ASSERT(this->barrIsCIDSet[eCID]);
-		if (pSeek->pvPrivateData == pvPrivateData)
+		const CID_PRIVDATA_NODE& node = this->privateData[wNode];
+		if (node.pvPrivateData == pvPrivateData)
 			return true; //Found it.
-		++pSeek;
+		wNode = node.wNextNode;
 	}
 
 	//Didn't find it.
@@ -313,21 +343,36 @@ bool CCueEvents::Remove(
 	ASSERT(IS_VALID_CID(eCID));
 	ASSERT(pvPrivateData);
 
-	vector<CID_PRIVDATA_NODE>::iterator pSeek = this->CIDPrivateData[eCID].begin();
-	const vector<CID_PRIVDATA_NODE>::const_iterator pSeekEnd = this->CIDPrivateData[eCID].end();
+	CID_PRIVDATA_LIST& list = this->CIDPrivateData[eCID];
 
 	//Each iteration checks on private data for a matching pointer.
-	while (pSeek != pSeekEnd)
+	UINT wPrevNode = NO_NODE;
+	for (UINT wNode = list.wFirstNode; wNode != NO_NODE; )
 	{
 		ASSERT(this->barrIsCIDSet[eCID]);
-		if (pSeek->pvPrivateData == pvPrivateData)
+		CID_PRIVDATA_NODE& node = this->privateData[wNode];
+		if (node.pvPrivateData == pvPrivateData)
 		{
-			if (pSeek->bIsAttached)
-				delete pSeek->pvPrivateData;
-			this->CIDPrivateData[eCID].erase(pSeek);
+			//Unlink the node.  It stays in the arena until the next Clear().
+			if (wPrevNode == NO_NODE)
+				list.wFirstNode = node.wNextNode;
+			else
+				this->privateData[wPrevNode].wNextNode = node.wNextNode;
+			if (list.wLastNode == wNode)
+				list.wLastNode = wPrevNode;
+			--list.wCount;
+
+			if (this->wNextCID == (UINT)eCID && this->wNextNode == wNode)
+				this->wNextNode = node.wNextNode;
+
+			if (node.bIsAttached)
+				delete node.pvPrivateData;
+			node.pvPrivateData = NULL;
+			node.bIsAttached = false;
 			return true; //Found it.
 		}
-		++pSeek;
+		wPrevNode = wNode;
+		wNode = node.wNextNode;
 	}
 
 	//Didn't find it.
@@ -347,10 +392,15 @@ void CCueEvents::Zero()
 	ASSERT(sizeof(this->CIDPrivateData) ==
 			sizeof(this->CIDPrivateData[0]) * CUEEVENT_COUNT);
 
-	this->wNextPrivateDataIndex = 0;
+	this->wNextNode = NO_NODE;
 	this->wNextCID = (UINT)-1;
 	memset(this->barrIsCIDSet, 0, sizeof(this->barrIsCIDSet));
 	for (UINT wCID=CUEEVENT_COUNT; wCID--; )
-		this->CIDPrivateData[wCID].clear();
-	this->wEventCount = 0;
+	{
+		CID_PRIVDATA_LIST& list = this->CIDPrivateData[wCID];
+		list.wFirstNode = list.wLastNode = NO_NODE;
+		list.wCount = 0;
+	}
+	this->firedCIDs.clear();
+	this->privateData.clear();
 }
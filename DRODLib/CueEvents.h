@@ -875,10 +875,18 @@ class CAttachableObject;
 struct CID_PRIVDATA_NODE
 {
 	CID_PRIVDATA_NODE(const bool bIsAttached, const CAttachableObject *pvPrivateData)
-		: bIsAttached(bIsAttached), pvPrivateData(pvPrivateData) { }
+		: bIsAttached(bIsAttached), pvPrivateData(pvPrivateData), wNextNode(UINT(-1)) { }
 
 	bool bIsAttached;
-	const CAttachableObject *pvPrivateData;
+	const CAttachableObject *pvPrivateData; //NULL when removed
+	UINT wNextNode;   //index of next node for the same event, or -1
+};
+
+//Where the private data of one event lie in the node arena.
+struct CID_PRIVDATA_LIST
+{
+	UINT wFirstNode, wLastNode; //-1 when empty
+	UINT wCount;
 };
 
 //******************************************************************************************
@@ -895,7 +903,7 @@ public:
 	void		ClearEvent(const CUEEVENT_ID eCID, const bool bDeleteAttached=true);
 	const CAttachableObject* GetFirstPrivateData(const CUEEVENT_ID eCID);
 	const CAttachableObject* GetNextPrivateData();
-	inline UINT GetEventCount() const {return this->wEventCount;}
+	inline UINT GetEventCount() const {return this->firedCIDs.size();}
 	UINT     GetOccurrenceCount(const CUEEVENT_ID eCID) const;
 	inline bool HasOccurred(const CUEEVENT_ID eCID) const {ASSERT(IS_VALID_CID(eCID)); return this->barrIsCIDSet[eCID];}
 	bool     HasOccurredWith(const CUEEVENT_ID eCID, const CAttachableObject *pvPrivateData) const;
@@ -903,12 +911,16 @@ public:
 	bool     Remove(const CUEEVENT_ID eCID, const CAttachableObject *pvPrivateData);
 
 protected:
-	UINT     wNextPrivateDataIndex, wNextCID;
+	UINT     wNextNode, wNextCID;
 
+	//Only the entries of events listed in firedCIDs are ever non-empty,
+	//so resetting for the next turn touches just those.
 	bool           barrIsCIDSet[CUEEVENT_COUNT];
-	vector<CID_PRIVDATA_NODE>  CIDPrivateData[CUEEVENT_COUNT];
+	CID_PRIVDATA_LIST CIDPrivateData[CUEEVENT_COUNT];
 
-	UINT     wEventCount;
+	vector<CUEEVENT_ID> firedCIDs;          //events that have occurred
+	vector<CID_PRIVDATA_NODE> privateData;  //node arena for all events' private data,
+	                                        //emptied but not freed between turns
 
 private:
 	void     Zero();
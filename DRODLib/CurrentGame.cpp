@@ -67,6 +67,10 @@
 
 #define NO_CHECKPOINT (static_cast<UINT>(-1))
 
+//Don't store more than this many room play snapshots to avoid sucking up too much
+//memory in pathological room environments.
+#define MAX_SNAPSHOTS (60)
+
 queue<DEMO_UPLOAD*> CCurrentGame::demosForUpload;
 
 //Game character/monster constant that speaker refers to
@@ -357,6 +361,8 @@ void CCurrentGame::Clear(
 	delete this->pLevel;
 	this->pLevel = NULL;
 
+	this->roomPrefetch.Clear();
+
 	if (bNewGame)
 	{
 		//Only reset the hold, room lists, and mastery if a new game is beginning
@@ -563,25 +569,23 @@ WSTRING CCurrentGame::ExpandText(const WCHAR* wText,
 						if (varID)
 						{
 							//Yes -- get its value, if defined.
-							char *varName = this->pHold->getVarAccessToken(wEscapeStr.c_str());
-							const UNPACKEDVARTYPE vType = this->stats.GetVarType(varName);
+							const UNPACKEDVARTYPE vType = this->stats.GetHoldVarType(varID);
 							const bool bExistingIntValue = vType == UVT_int || vType == UVT_uint;
 							if (bExistingIntValue)
 							{
 								//Integer.
-								const int nVal = this->stats.GetVar(varName, int(0));
+								const int nVal = this->stats.GetHoldVarInt(varID);
 								wStr += _itoW(nVal, wIntText, 10);
 							} else if (vType == UVT_wchar_string || vType == UVT_unknown) {
 								//A text string.
-								wStr += this->stats.GetVar(varName, wszEmpty);
+								wStr += this->stats.GetHoldVarText(varID, wszEmpty);
 							}
 						} else {
 							//Might be a complex expression.  Does it parse?
 							UINT index=0;
 							if (CCharacter::IsValidExpression(wEscapeStr.c_str(), index, this->pHold))
 							{
-								index=0;
-								const int nVal = CCharacter::parseExpression(wEscapeStr.c_str(), index, this);
+								const int nVal = CCharacter::evalExpression(wEscapeStr, this);
 								wStr += _itoW(nVal, wIntText, 10);
 							}
 						}
@@ -667,6 +671,82 @@ const
 	return dwSum;
 }
 
+//*****************************************************************************
+static ULONGLONG MixStateHash(ULONGLONG h)
+//Scrambles the bits of a 64-bit value (SplitMix64 finalizer).
+{
+	h += 0x9E3779B97F4A7C15ULL;
+	h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+	return h ^ (h >> 31);
+}
+
+//*****************************************************************************
+static inline ULONGLONG TileStateKey(const UINT wLayer, const UINT square, const UINT value)
+//Returns: the Zobrist key for a value occupying one square of one layer
+{
+	return MixStateHash((ULONGLONG(wLayer) << 56) ^ (ULONGLONG(square) << 32) ^ value);
+}
+
+//*****************************************************************************
+ULONGLONG CCurrentGame::GetStateHash()
+//Gets a 64-bit hash of the room's tile layers, its monsters, the player and
+//the game vars.  Unlike GetChecksum, this is meant to change whenever anything
+//in the game state does, so replays that diverge can be caught on the first turn
+//they differ.  It is not stored with demos, since it depends on implementation
+//details that may change between versions.
+//
+//Returns:
+//The hash.
+const
+{
+	ASSERT(this->pRoom);
+	const CDbRoom& room = *this->pRoom;
+
+	//Tile layers: each occupied square contributes a key for its tile.
+	ULONGLONG hash = 0;
+	const UINT dwArea = room.CalcRoomArea();
+	for (UINT square = 0; square < dwArea; ++square)
+	{
+		hash ^= TileStateKey(0, square, BYTE(room.pszOSquares[square]));
+		hash ^= TileStateKey(1, square, BYTE(room.pszFSquares[square]));
+		const RoomObject *pTObj = room.tLayer[square];
+		if (pTObj)
+			hash ^= TileStateKey(2, square, pTObj->tile) ^ TileStateKey(3, square, pTObj->param);
+	}
+
+	//Monsters are mixed in list order, since the order they move in matters too.
+	for (const CMonster *pMonster = room.pFirstMonster; pMonster; pMonster = pMonster->pNext)
+	{
+		hash = MixStateHash(hash ^ pMonster->GetIdentity());
+		hash = MixStateHash(hash ^ ((pMonster->wX << 16) + (pMonster->wY << 4) + pMonster->wO));
+		hash = MixStateHash(hash ^ UINT(pMonster->IsAlive()));
+	}
+
+	//Player.
+	hash = MixStateHash(hash ^ ((this->swordsman.wX << 16) + (this->swordsman.wY << 4) +
+			this->swordsman.wO));
+	hash = MixStateHash(hash ^ ((this->swordsman.wIdentity << 16) + this->swordsman.wAppearance));
+	hash = MixStateHash(hash ^ ((this->swordsman.localRoomWeaponType << 4) +
+			(this->swordsman.bWeaponSheathed ? 1 : 0) + (this->swordsman.bNoWeapon ? 2 : 0) +
+			(this->swordsman.bIsDying ? 4 : 0) + (this->swordsman.bIsHasted ? 8 : 0)));
+
+	//Turn counters and room state counters.
+	hash = MixStateHash(hash ^ ((ULONGLONG(this->wTurnNo) << 32) + this->wSpawnCycleCount));
+	hash = MixStateHash(hash ^ ((ULONGLONG(room.wMonsterCount) << 32) + room.wTarLeft));
+	hash = MixStateHash(hash ^ ((ULONGLONG(room.wTrapDoorsLeft) << 32) +
+			this->ConqueredRooms.size() * 0x10000 + this->ExploredRooms.size()));
+
+	//Vars, as they are packed for saving (in name order).
+	UINT dwVarBufSize;
+	BYTE *pVarBuf = this->stats.GetPackedBuffer(dwVarBufSize);
+	for (UINT i = 0; i < dwVarBufSize; ++i)
+		hash = (hash ^ pVarBuf[i]) * 0x100000001B3ULL; //FNV-1a
+	delete[] pVarBuf;
+
+	return MixStateHash(hash);
+}
+
 //*****************************************************************************
 void CCurrentGame::GetLevelStats(CDbLevel *pLevel)
 //Extract stats for this level from packed vars.
@@ -1737,12 +1817,18 @@ bool CCurrentGame::PlayAllCommands(
 //
 //Params:
 	CCueEvents &CueEvents,     //(out)  Cue events generated by last processed command.
-	const bool bTruncateInvalidCommands)   //(in) delete any commands that cannot be played back [default=false]
+	const bool bTruncateInvalidCommands,   //(in) delete any commands that cannot be played back [default=false]
+	vector<ULONGLONG> *pStateHashTrace)    //(out) if not NULL, receives GetStateHash() after
+	                                       //each command played, for finding where a replay
+	                                       //diverges [default=NULL]
 //
 //Returns:
 //True if commands were successfully played without putting the game into an
 //unexpected state, false if not.
 {
+	if (pStateHashTrace)
+		pStateHashTrace->clear();
+
 	if (this->Commands.Empty())
 		return true; //no commands to process
 
@@ -1781,6 +1867,8 @@ bool CCurrentGame::PlayAllCommands(
 		if (bIsComplexCommand(nCommand)) //handle multi-part commands here
 			VERIFY(commands.GetData(wX,wY));
 		ProcessCommand(nCommand, CueEvents, wX, wY);
+		if (pStateHashTrace)
+			pStateHashTrace->push_back(GetStateHash());
 
 		//Check for game states that indicate further commands would be invalid.
 		//Note: a possible reason for getting these errors is that the current version
@@ -1930,6 +2018,19 @@ void CCurrentGame::PostProcessCharacter(CCharacter* pCharacter, CCueEvents& CueE
 	}
 }
 
+//*****************************************************************************
+bool CCurrentGame::PrefetchAdjacentRoom()
+//Loads one of the rooms bordering the current room ahead of time, so leaving
+//the room in that direction won't have to load it.  Call while the player is idle.
+//
+//Returns: whether a room was looked up, i.e. more rooms may remain to prefetch
+{
+	if (!this->pLevel || !this->pRoom || this->Commands.IsFrozen())
+		return false;
+
+	return this->roomPrefetch.PrefetchNext(*this->pLevel, *this->pRoom);
+}
+
 //*****************************************************************************
 void CCurrentGame::ProcessCommand(
 //Processes a game command, causing game data and current room to be updated
@@ -2292,6 +2393,41 @@ void CCurrentGame::SnapshotGameState()
 		pNewSnapshot->pSnapshotGame = this->pSnapshotGame;
 		this->pSnapshotGame = pNewSnapshot;
 		++this->numSnapshots;
+
+		if (this->numSnapshots > MAX_SNAPSHOTS)
+			ThinSnapshots();
+	}
+}
+
+//***************************************************************************************
+void CCurrentGame::ThinSnapshots()
+//Keeps the snapshot queue within MAX_SNAPSHOTS without ceasing to take new ones.
+//
+//The most recent half of the queue is left intact, while every other snapshot
+//in the older half is discarded.  Repeated thinning spaces older snapshots
+//progressively further apart, so rewinding a few turns stays fast however long
+//the player has been in the room, while far rewinds replay a bounded span.
+{
+	UINT wIndex = 0;
+	const UINT wKeep = this->numSnapshots / 2;
+	CCurrentGame *pSnapshot = this->pSnapshotGame;
+	while (pSnapshot && wIndex < wKeep)
+	{
+		pSnapshot = pSnapshot->pSnapshotGame;
+		++wIndex;
+	}
+
+	while (pSnapshot)
+	{
+		CCurrentGame *pDelete = pSnapshot->pSnapshotGame;
+		if (!pDelete)
+			break;
+		pSnapshot->pSnapshotGame = pDelete->pSnapshotGame;
+		pDelete->pSnapshotGame = NULL; //don't destroy the earlier snapshots
+		delete pDelete;
+		--this->numSnapshots;
+
+		pSnapshot = pSnapshot->pSnapshotGame;
 	}
 }
 
@@ -4246,7 +4382,11 @@ void CCurrentGame::SetTurn(
 		SetMembers(*pSnapshot);
 
 		//Hook in this and earlier snapshots.
+		//The restored count may predate thinning of the queue, so recount.
 		this->pSnapshotGame = pSnapshot;
+		this->numSnapshots = 0;
+		for ( ; pSnapshot != NULL; pSnapshot = pSnapshot->pSnapshotGame)
+			++this->numSnapshots;
 
 		//Restore command list.
 		this->Commands = commands; //Commands may or may not be truncated by caller.
@@ -5041,6 +5181,23 @@ bool CCurrentGame::LoadNorthRoom()
 	return true;
 }
 
+//*****************************************************************************
+CDbRoom* CCurrentGame::LoadRoomAtCoords(
+//Gets a room on this level, taking it from the prefetched rooms if it's there.
+//
+//Returns: pointer to a new loaded room object which caller must delete,
+//or NULL if the room could not be loaded
+//
+//Params:
+	const UINT dwRoomX, const UINT dwRoomY) //(in) coords of room to get
+{
+	ASSERT(this->pLevel);
+	CDbRoom *pRoom = this->roomPrefetch.Take(this->pLevel->dwLevelID, dwRoomX, dwRoomY);
+	if (!pRoom)
+		pRoom = this->pLevel->GetRoomAtCoords(dwRoomX, dwRoomY);
+	return pRoom;
+}
+
 //***************************************************************************************
 bool CCurrentGame::LoadSouthRoom()
 //Loads room south of the current room in the context of the swordsman exiting
@@ -5129,7 +5286,7 @@ bool CCurrentGame::PlayerCanExitRoom(
 	}
 
 	//Attempt to load room.
-	pNewRoom = this->pLevel->GetRoomAtCoords(dwNewRoomX, dwNewRoomY);
+	pNewRoom = LoadRoomAtCoords(dwNewRoomX, dwNewRoomY);
 	if (!pNewRoom)
 		return false;
 
@@ -7124,7 +7281,7 @@ bool CCurrentGame::SetRoomAtCoords(
 //stay loaded.
 {
 	//Load new room.
-	CDbRoom *pNewRoom = this->pLevel->GetRoomAtCoords(dwRoomX, dwRoomY);
+	CDbRoom *pNewRoom = LoadRoomAtCoords(dwRoomX, dwRoomY);
 	if (!pNewRoom)
 		return false;
 
@@ -7348,12 +7505,7 @@ bool CCurrentGame::TakeSnapshotNow() const
 	if (turnsSinceLastSnapshot < MIN_TURNS_PER_SNAPSHOT)
 		return false;
 
-	//Don't store more than this many snapshots to avoid sucking up too much
-	//memory in pathological room environments.
-	static const UINT MAX_SNAPSHOTS = 60;
-	if (this->numSnapshots > MAX_SNAPSHOTS)
-		return false;
-
+	//Memory use is bounded by thinning out older snapshots (see ThinSnapshots).
 	return true;
 }
 
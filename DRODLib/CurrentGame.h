@@ -78,6 +78,9 @@
 #include "CurrentGameRecords.h"
 #include "DemoRecInfo.h"
 #include "DbSavedGames.h"
+#include "PathSearch.h"
+#include "RoomPrefetch.h"
+#include "ScriptExpression.h"
 #include "GameConstants.h"
 #include "Monster.h"
 #include "MonsterMessage.h"
@@ -167,7 +170,8 @@ protected:
 	CCurrentGame();
 	CCurrentGame(const CCurrentGame &Src)
 		: CDbSavedGame(false), pRoom(NULL), pLevel(NULL),
-		  pHold(NULL), pEntrance(NULL), pSnapshotGame(NULL)
+		  pHold(NULL), pEntrance(NULL),
+		  pathSearchContext(Src.pathSearchContext), pSnapshotGame(NULL)
 	{SetMembers(Src);}
 
 public:
@@ -192,6 +196,7 @@ public:
 	void     FreezeCommands();
 	UINT     GetAutoSaveOptions() const {return this->dwAutoSaveOptions;}
 	UINT     GetChecksum() const;
+	ULONGLONG GetStateHash() const;
 	int      GetCutSceneStartTurn() const {return this->cutSceneStartTurn;}
 	const CEntity* GetDyingEntity() const {return this->pDyingEntity;}
 	const CEntity* GetKillingEntity() const {return this->pKillingEntity;}
@@ -240,8 +245,10 @@ public:
 	bool     LoadNewRoomForExit(const UINT wExitO, CCueEvents &CueEvents);
 	void     LoadPrep(const bool bNewGame=true);
 	bool     PlayAllCommands(CCueEvents &CueEvents,
-			const bool bTruncateInvalidCommands=false);
+			const bool bTruncateInvalidCommands=false,
+			vector<ULONGLONG> *pStateHashTrace=NULL);
 	bool     PlayCommandsToTurn(const UINT wEndTurnNo, CCueEvents &CueEvents);
+	bool     PrefetchAdjacentRoom();
 	bool     PlayerEnteredTunnel(const UINT wOTileNo, const UINT wMoveO, UINT wRole = M_NONE) const;
 	void     PostProcessCharacter(CCharacter* pCharacter, CCueEvents& CueEvents);
 	void     ProcessCommandSetVar(const UINT itemID, UINT newVal);
@@ -314,6 +321,9 @@ public:
 	CDbHold *   pHold;
 	CEntranceData *pEntrance;
 
+	CScriptExpressionCache scriptExpressions; //compiled NPC script expressions for this hold
+	CPathSearchContext pathSearchContext; //monster pathfinding buffers and per-move caches
+
 	//Player state
 	CSwordsman swordsman;
 
@@ -384,6 +394,7 @@ private:
 	bool     LoadNorthRoom();
 	bool     LoadSouthRoom();
 	bool     LoadWestRoom();
+	CDbRoom* LoadRoomAtCoords(const UINT dwRoomX, const UINT dwRoomY);
 	bool     PlayerCanExitRoom(const UINT wDirection, UINT &dwNewSX,
 			UINT &dwNewSY, CDbRoom* &pNewRoom);
 	void     ProcessCheckpointActivation(CCueEvents& CueEvents);
@@ -426,6 +437,7 @@ private:
 	bool     SwitchToCloneAt(const UINT wX, const UINT wY);
 	bool     TakeSnapshotNow() const;
 	void     TallyMonsterKilledByPlayerThisTurn();
+	void     ThinSnapshots();
 	bool     ToggleGreenDoors(CCueEvents& CueEvents);
 	bool     TunnelMove(const int dx, const int dy);
 	void     UpdatePrevCoords();
@@ -463,6 +475,7 @@ private:
 	bool     bWasRoomConqueredAtTurnStart;
 
 	CCurrentGame *pSnapshotGame; //for optimized room rewinds
+	CRoomPrefetch roomPrefetch;  //rooms bordering the current room, loaded ahead of time
 	UINT dwComputationTime; //time required to process game moves up to this point
 	UINT dwComputationTimePerSnapshot; //real movement computation time between game state snapshots
 	UINT numSnapshots;
@@ -170,6 +170,14 @@ SOURCE=.\PlayerStats.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\ScriptExpression.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\ScriptExpression.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\SettingsKeys.cpp
 # End Source File
 # Begin Source File
@@ -750,6 +758,22 @@ SOURCE=.\PathMap.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\PathSearch.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\PathSearch.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\RoomPrefetch.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\RoomPrefetch.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Platform.cpp
 # End Source File
 # Begin Source File
@@ -381,6 +381,92 @@ roomMap roomIndex; //room -> saved games + demos
 idMap demoIndex; //demo -> saved game
 idMap demosHoldIndex; //demo -> hold
 
+typedef map<UINT,CIDSet> holdSavedGameMap;
+
+//Each player's hold progress saved games, built on first query for that player.
+struct PlayerProgress {
+	PlayerProgress() : bTotalRoomsLoaded(false) {}
+	holdSavedGameMap continueIDs, endHoldIDs; //hold -> saved games
+	CIDSet playerTotalIDs;
+	bool bTotalRoomsLoaded;
+	CIDSet conqueredRooms, exploredRooms; //in first player total saved game
+};
+typedef map<UINT,PlayerProgress> playerProgressMap;
+
+struct ProgressEntry {
+	UINT playerID, holdID;
+	SAVETYPE eType;
+};
+typedef map<UINT,ProgressEntry> progressEntryMap;
+
+playerProgressMap playerProgressIndex; //player -> progress saved games
+progressEntryMap progressEntryIndex; //saved game -> where it is filed in playerProgressIndex
+
+//*****************************************************************************
+static bool isProgressSaveType(const SAVETYPE eType)
+//Returns: whether saved games of this type are tracked in the progress index
+{
+	return eType == ST_Continue || eType == ST_EndHold || eType == ST_PlayerTotal;
+}
+
+//*****************************************************************************
+static void addProgressEntry(
+//Files a saved game in its player's progress index.
+//
+//Params:
+	PlayerProgress& progress, const UINT savedGameID, const UINT playerID,
+	const UINT holdID, const SAVETYPE eType)
+{
+	switch (eType)
+	{
+		case ST_Continue: progress.continueIDs[holdID] += savedGameID; break;
+		case ST_EndHold: progress.endHoldIDs[holdID] += savedGameID; break;
+		case ST_PlayerTotal:
+			progress.playerTotalIDs += savedGameID;
+			progress.bTotalRoomsLoaded = false;
+		break;
+		default: ASSERT(!"Saved game type not tracked in progress index"); return;
+	}
+
+	ProgressEntry entry;
+	entry.playerID = playerID;
+	entry.holdID = holdID;
+	entry.eType = eType;
+	progressEntryIndex[savedGameID] = entry;
+}
+
+//*****************************************************************************
+static void removeProgressEntry(const UINT savedGameID)
+//Removes a saved game from the progress index, if it is filed there.
+{
+	progressEntryMap::iterator entry = progressEntryIndex.find(savedGameID);
+	if (entry == progressEntryIndex.end())
+		return;
+
+	playerProgressMap::iterator player = playerProgressIndex.find(entry->second.playerID);
+	ASSERT(player != playerProgressIndex.end());
+	PlayerProgress& progress = player->second;
+	switch (entry->second.eType)
+	{
+		case ST_Continue: progress.continueIDs[entry->second.holdID] -= savedGameID; break;
+		case ST_EndHold: progress.endHoldIDs[entry->second.holdID] -= savedGameID; break;
+		case ST_PlayerTotal:
+			progress.playerTotalIDs -= savedGameID;
+			progress.bTotalRoomsLoaded = false;
+		break;
+		default: ASSERT(!"Saved game type not tracked in progress index"); break;
+	}
+	progressEntryIndex.erase(entry);
+}
+
+//*****************************************************************************
+static void resetProgressIndex()
+//Discards all players' progress indices.  They are rebuilt on next query.
+{
+	playerProgressIndex.clear();
+	progressEntryIndex.clear();
+}
+
 //*****************************************************************************
 void CDb::addDataToHold(const UINT dataID, const UINT holdID)
 //Adds dataID to hold's data set.
@@ -545,6 +631,7 @@ void CDb::deleteRoom(const UINT roomID)
 	if (roomIter != roomIndex.end())
 	{
 		roomIndex.erase(roomIter);
+		resetProgressIndex(); //saved games here no longer belong to a hold
 		//Delete room from level that owns it.
 		const UINT levelID = CDbRooms::GetLevelIDForRoom(roomID);
 		if (levelID)
@@ -567,6 +654,17 @@ void CDb::deleteSavedGame(const UINT savedGameID)
 	roomMap::iterator room = roomIndex.find(roomID);
 	if (room != roomIndex.end())
 		room->second.savedGameIDs -= savedGameID;
+
+	removeProgressEntry(savedGameID);
+}
+
+//*****************************************************************************
+UINT CDb::getContinueSavedGame(const UINT holdID, const UINT playerID)
+//Returns: ID of the player's continue saved game in this hold, or 0 if none
+{
+	const PlayerProgress& progress = playerProgressIndex[indexPlayerProgress(playerID)];
+	holdSavedGameMap::const_iterator hold = progress.continueIDs.find(holdID);
+	return hold != progress.continueIDs.end() ? hold->second.getFirst() : 0;
 }
 
 //*****************************************************************************
@@ -611,6 +709,15 @@ CIDSet CDb::getDemosInRoom(const UINT roomID)
 	return roomIter->second.demoIDs;
 }
 
+//*****************************************************************************
+UINT CDb::getEndHoldSavedGame(const UINT holdID, const UINT playerID)
+//Returns: ID of the player's end hold saved game for this hold, or 0 if none
+{
+	const PlayerProgress& progress = playerProgressIndex[indexPlayerProgress(playerID)];
+	holdSavedGameMap::const_iterator hold = progress.endHoldIDs.find(holdID);
+	return hold != progress.endHoldIDs.end() ? hold->second.getFirst() : 0;
+}
+
 //*****************************************************************************
 UINT CDb::getHoldOfDemo(const UINT demoID)
 //Returns: holdID of the hold that this demo is in
@@ -629,6 +736,37 @@ CIDSet CDb::getLevelsInHold(const UINT holdID)
 	return holdIter->second.levelIDs;
 }
 
+//*****************************************************************************
+CIDSet CDb::getPlayerTotalRooms(
+//Returns: rooms recorded in the player's room tally saved game, or empty set if none
+//
+//Params:
+	const UINT playerID,  //(in)
+	const bool bConquered) //(in) conquered rooms if set, otherwise explored rooms
+{
+	PlayerProgress& progress = playerProgressIndex[indexPlayerProgress(playerID)];
+	if (progress.playerTotalIDs.empty())
+		return CIDSet();
+
+	//The tallies are large, so keep them until the saved game is next written.
+	if (!progress.bTotalRoomsLoaded)
+	{
+		const UINT savedGameID = progress.playerTotalIDs.getFirst();
+		progress.conqueredRooms = CDbSavedGames::GetConqueredRooms(savedGameID);
+		progress.exploredRooms = CDbSavedGames::GetExploredRooms(savedGameID);
+		progress.bTotalRoomsLoaded = true;
+	}
+	return bConquered ? progress.conqueredRooms : progress.exploredRooms;
+}
+
+//*****************************************************************************
+UINT CDb::getPlayerTotalSavedGame(const UINT playerID)
+//Returns: ID of the player's room tally saved game, or 0 if none
+{
+	const PlayerProgress& progress = playerProgressIndex[indexPlayerProgress(playerID)];
+	return progress.playerTotalIDs.getFirst();
+}
+
 //*****************************************************************************
 CIDSet CDb::getRoomsInHold(const UINT holdID)
 //Returns: set of roomIDs belonging to this hold, or empty set if level doesn't exist
@@ -694,6 +832,74 @@ bool CDb::holdExists(const UINT holdID)
 	return holdIndex.count(holdID) != 0;
 }
 
+//*****************************************************************************
+UINT CDb::indexPlayerProgress(const UINT playerID)
+//Builds the player's progress index in one pass over the saved games, unless
+//it has already been built.
+//
+//Returns: playerID
+{
+	ASSERT(playerID);
+	if (playerProgressIndex.count(playerID))
+		return playerID;
+
+	PlayerProgress& progress = playerProgressIndex[playerID];
+	map<UINT,UINT> holdOfRoom; //rooms looked up during this pass
+	const UINT savedGameCount = GetViewSize(V_SavedGames);
+	for (UINT savedGameI = 0; savedGameI < savedGameCount; ++savedGameI)
+	{
+		c4_RowRef row = GetRowRef(V_SavedGames, savedGameI);
+		if (UINT(p_PlayerID(row)) != playerID)
+			continue;
+		const SAVETYPE eType = SAVETYPE(int(p_Type(row)));
+		if (!isProgressSaveType(eType))
+			continue;
+
+		UINT holdID = 0;
+		if (eType != ST_PlayerTotal)
+		{
+			const UINT roomID = UINT(p_RoomID(row));
+			if (!roomID)
+				continue; //not yet in a hold
+			map<UINT,UINT>::const_iterator room = holdOfRoom.find(roomID);
+			if (room != holdOfRoom.end())
+				holdID = room->second;
+			else
+				holdID = holdOfRoom[roomID] = CDbRooms::GetHoldIDForRoom(roomID);
+			if (!holdID)
+				continue; //dangling room ID
+		}
+		addProgressEntry(progress, UINT(p_SavedGameID(row)), playerID, holdID, eType);
+	}
+	return playerID;
+}
+
+//*****************************************************************************
+void CDb::indexSavedGameProgress(
+//Updates the progress index after a saved game record has been written.
+//
+//Params:
+	const UINT savedGameID, const UINT playerID, const UINT roomID, //(in)
+	const SAVETYPE eType) //(in)
+{
+	removeProgressEntry(savedGameID);
+
+	if (!isProgressSaveType(eType))
+		return;
+	playerProgressMap::iterator player = playerProgressIndex.find(playerID);
+	if (player == playerProgressIndex.end())
+		return; //player's index will include this saved game when it is built
+
+	UINT holdID = 0;
+	if (eType != ST_PlayerTotal)
+	{
+		holdID = roomID ? CDbRooms::GetHoldIDForRoom(roomID) : 0;
+		if (!holdID)
+			return;
+	}
+	addProgressEntry(player->second, savedGameID, playerID, holdID, eType);
+}
+
 //*****************************************************************************
 bool CDb::levelExists(const UINT levelID)
 {
@@ -734,6 +940,9 @@ void CDb::moveRoom(const UINT roomID, const UINT fromLevelID, const UINT toLevel
 	if (fromLevelID == toLevelID)
 		return; //room is in the same level as before
 
+	//Saved games in this room may now belong to a different hold.
+	resetProgressIndex();
+
 	//Remove room index from previous level.
 	levelMap::iterator level = levelIndex.find(fromLevelID);
 	ASSERT(level != levelIndex.end());
@@ -779,6 +988,8 @@ void CDb::resetIndex()
 	roomIndex.clear();
 	demoIndex.clear();
 	demosHoldIndex.clear();
+	resetProgressIndex();
+	this->Rooms.ResetMapTiles();
 
 	CDbBase::resetIndex();
 }
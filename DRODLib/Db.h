@@ -110,12 +110,16 @@ public:
 	static void   deleteLevel(const UINT levelID);
 	static void   deleteRoom(const UINT roomID);
 	static void   deleteSavedGame(const UINT savedGameID);
+	static UINT   getContinueSavedGame(const UINT holdID, const UINT playerID);
 	static CIDSet getDataInHold(const UINT holdID);
 	static CIDSet getDemosInHold(const UINT holdID);
 	static CIDSet getDemosInLevel(const UINT levelID);
 	static CIDSet getDemosInRoom(const UINT roomID);
+	static UINT   getEndHoldSavedGame(const UINT holdID, const UINT playerID);
 	static UINT   getHoldOfDemo(const UINT demoID);
 	static CIDSet getLevelsInHold(const UINT holdID);
+	static CIDSet getPlayerTotalRooms(const UINT playerID, const bool bConquered);
+	static UINT   getPlayerTotalSavedGame(const UINT playerID);
 	static CIDSet getRoomsInHold(const UINT holdID);
 	static CIDSet getRoomsInLevel(const UINT levelID);
 	static UINT   getSavedGameOfDemo(const UINT demoID);
@@ -123,6 +127,8 @@ public:
 	static CIDSet getSavedGamesInLevel(const UINT levelID);
 	static CIDSet getSavedGamesInRoom(const UINT roomID);
 	static bool   holdExists(const UINT holdID);
+	static void   indexSavedGameProgress(const UINT savedGameID, const UINT playerID,
+			const UINT roomID, const SAVETYPE eType);
 	static bool   levelExists(const UINT levelID);
 	static void   moveData(const UINT dataID, const UINT fromHoldID, const UINT toHoldID);
 	static void   moveRoom(const UINT roomID, const UINT fromLevelID, const UINT toLevelID);
@@ -135,6 +141,7 @@ private:
 
 	virtual void resetIndex();
 	virtual void buildIndex();
+	static UINT  indexPlayerProgress(const UINT playerID);
 
 	static UINT      dwCurrentHoldID, dwCurrentPlayerID;
 	static bool       bFreezeTimeStamps;
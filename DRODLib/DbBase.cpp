@@ -93,6 +93,111 @@ typedef map<UINT,CIDSet> messageIDsMap;
 messageIDsMap messageIndex; //message -> global rows in DB
 CIDSet messageIDsMarkedForDeletion;
 
+//Message texts already read from the DB, in the language they were looked up for.
+//Callers may keep the returned pointers, so a text that is replaced is retired
+//rather than freed until the index is reset.
+struct InternedMessageText
+{
+	UINT language;
+	WSTRING text;
+};
+typedef map<UINT,InternedMessageText*> internedTextMap;
+internedTextMap internedTexts; //message -> text
+vector<InternedMessageText*> retiredTexts;
+
+//Texts this long are probably corrupted data.  Only the first part is shown.
+static const UINT MAXLEN_SMALL_BUF = 500, MAXLEN_LARGE_BUF = 10000;
+
+//*****************************************************************************
+static void forgetMessageText(const UINT messageID)
+//Drops the interned text for a message whose texts have changed.
+{
+	internedTextMap::iterator text = internedTexts.find(messageID);
+	if (text != internedTexts.end())
+	{
+		retiredTexts.push_back(text->second);
+		internedTexts.erase(text);
+	}
+}
+
+//*****************************************************************************
+static void clearInternedTexts()
+{
+	for (internedTextMap::const_iterator text = internedTexts.begin();
+			text != internedTexts.end(); ++text)
+		delete text->second;
+	internedTexts.clear();
+	for (vector<InternedMessageText*>::const_iterator retired = retiredTexts.begin();
+			retired != retiredTexts.end(); ++retired)
+		delete *retired;
+	retiredTexts.clear();
+}
+
+//Accelerated primary key lookup.
+//For each view type in each DB file, the row of each record ID local to that
+//file's view, addressed directly by the ID's offset from the lowest ID.
+struct PrimaryKeyRows
+{
+	PrimaryKeyRows() : dwFirstID(0), dwRowsIndexed(0) {}
+
+	//Returns: the indexed row for this ID, or ROW_NO_MATCH
+	UINT Get(const UINT dwID) const
+	{
+		const UINT dwOffset = dwID - this->dwFirstID; //IDs below the first wrap around
+		return dwOffset < this->rows.size() ? this->rows[dwOffset] : ROW_NO_MATCH;
+	}
+
+	void Set(const UINT dwID, const UINT dwRowI, const UINT dwMaxSpan)
+	{
+		if (!dwID)
+			return; //row not filled in yet
+		if (this->rows.empty())
+			this->dwFirstID = dwID;
+		if (dwID < this->dwFirstID)
+			return;
+		const UINT dwOffset = dwID - this->dwFirstID;
+		if (dwOffset >= this->rows.size())
+		{
+			if (dwOffset >= dwMaxSpan)
+				return; //IDs are too sparse to address directly -- leave to binary search
+			this->rows.resize(dwOffset + 1, ROW_NO_MATCH);
+		}
+		this->rows[dwOffset] = dwRowI;
+	}
+
+	//Indexes any rows appended to the view since the last lookup.
+	void Sync(const c4_IntProp& propID, const UINT rowCount, c4_View& View)
+	{
+		if (rowCount < this->dwRowsIndexed)
+			this->dwRowsIndexed = rowCount; //empty end rows were removed
+		const UINT dwMaxSpan = MaxSpan(rowCount);
+		for ( ; this->dwRowsIndexed < rowCount; ++this->dwRowsIndexed)
+			Set(UINT(propID(View[this->dwRowsIndexed])), this->dwRowsIndexed, dwMaxSpan);
+	}
+
+	//Shifts the rows following a deleted one.
+	void RemoveRow(const UINT dwID, const UINT dwRowI)
+	{
+		const UINT dwOffset = dwID - this->dwFirstID;
+		if (dwOffset < this->rows.size())
+			this->rows[dwOffset] = ROW_NO_MATCH;
+		for (vector<UINT>::iterator row = this->rows.begin(); row != this->rows.end(); ++row)
+			if (*row != ROW_NO_MATCH && *row > dwRowI)
+				--*row;
+		if (this->dwRowsIndexed > dwRowI)
+			--this->dwRowsIndexed;
+	}
+
+	static UINT MaxSpan(const UINT rowCount) {return 4 * rowCount + 4096;}
+
+	UINT dwFirstID;      //ID at rows[0]
+	UINT dwRowsIndexed;  //leading view rows scanned into the index
+	vector<UINT> rows;   //local row index for each ID, or ROW_NO_MATCH
+};
+typedef map<UINT, PrimaryKeyRows> PrimaryKeyFileMap; //DB file -> row index
+PrimaryKeyFileMap primaryKeyIndex[V_Count];
+const UINT LOCAL_DATA_FILE = UINT(-1); //key for the player's local content files
+
 //Used for checking the reference count at application exit.
 UINT GetDbRefCount() {return m_dbRefs.size();}
 
@@ -294,22 +399,30 @@ bool CDbBase::SetCreateDataFileNum(UINT num) {
 	return false;
 }
 
+//*****************************************************************************
+UINT CDbBase::GetDataFileNum(const UINT dwID)
+//Returns: which pre-packaged database (content pack) holds records with this ID,
+//or LOCAL_DATA_FILE for the player's local content databases
+{
+	if (dwID >= START_LOCAL_ID)
+		return LOCAL_DATA_FILE;
+
+	UINT dataFileNum = 0;
+	if (dwID >= MAX_IDS_IN_BASE_DAT)
+		dataFileNum = 1 + (dwID-MAX_IDS_IN_BASE_DAT) / MAX_IDS_IN_SINGLE_DLC_PACK; //ID block allocation strategy
+	if (m_pMainStorage.find(dataFileNum) == m_pMainStorage.end())
+		return 0; //gotta return something
+	return dataFileNum;
+}
+
 //*****************************************************************************
 c4_ViewRef CDbBase::GetView(const VIEWTYPE vType, const UINT dwID)
 //Returns: view reference from one of the databases.
 {
 	const char* viewName = ViewTypeStr(vType);
-	if (dwID < START_LOCAL_ID) {
-		//pre-packaged database (content pack)
-		UINT dataFileNum = 0;
-		if (dwID >= MAX_IDS_IN_BASE_DAT)
-			dataFileNum = 1 + (dwID-MAX_IDS_IN_BASE_DAT) / MAX_IDS_IN_SINGLE_DLC_PACK; //ID block allocation strategy
-		StaticStorageMap::const_iterator it = m_pMainStorage.find(dataFileNum);
-		if (it != m_pMainStorage.end())
-			return it->second->View(viewName);
-
-		return m_pMainStorage[0]->View(viewName); //gotta return something
-	}
+	const UINT dataFileNum = GetDataFileNum(dwID);
+	if (dataFileNum != LOCAL_DATA_FILE) //pre-packaged database (content pack)
+		return m_pMainStorage[dataFileNum]->View(viewName);
 
 	//The player's local content database.
 	return GetPlayerDataView(vType, viewName);
@@ -407,11 +520,22 @@ UINT CDbBase::LookupRowByPrimaryKey(
 	//Get specific view where primary key field is located.
 	View = GetView(vType, dwID);
 
-	//Binary search for ID.
 	ASSERT(rowCount < ROW_NO_MATCH);
 	if (rowCount == 0)
 		return ROW_NO_MATCH; //No rows to search.
 
+	//Consult the row index first.
+	//Rows not yet indexed, or moved by changes the index wasn't told about,
+	//fall through to the binary search.
+	ASSERT(vType < V_Count);
+	PrimaryKeyRows& index = primaryKeyIndex[vType][GetDataFileNum(dwID)];
+	index.Sync(*pPropID, rowCount, View);
+	const UINT dwIndexedRowI = index.Get(dwID);
+	if (dwIndexedRowI < rowCount && UINT((*pPropID)(View[dwIndexedRowI])) == dwID)
+		return dwIndexedRowI;
+
+	//Binary search for ID.
+
 	UINT dwFirstRowI = 0;
 	UINT dwLastRowI = rowCount - 1;
 	while (dwFirstRowI <= dwLastRowI) //Each iteration is one test at a new row position.
@@ -419,7 +543,10 @@ UINT CDbBase::LookupRowByPrimaryKey(
 		const UINT dwRowI = dwFirstRowI + (dwLastRowI - dwFirstRowI + 1) / 2;
 		const UINT dwThisID = UINT((*pPropID)(View[dwRowI]));
 		if (dwThisID == dwID)
+		{
+			index.Set(dwID, dwRowI, PrimaryKeyRows::MaxSpan(rowCount));
 			return dwRowI;
+		}
 		if (dwThisID < dwID)
 		{
 			dwFirstRowI = dwRowI + 1;
@@ -433,6 +560,22 @@ UINT CDbBase::LookupRowByPrimaryKey(
 	return ROW_NO_MATCH;
 }
 
+//*****************************************************************************
+void CDbBase::removePrimaryKeyRow(
+//Updates the primary key lookup index after a row has been removed from a view.
+//
+//Params:
+	const UINT dwID,      //(in) Primary key of the removed row
+	const VIEWTYPE vType, //(in) View the row was removed from
+	const UINT dwRowI)    //(in) Row index the record had, local to its view
+{
+	ASSERT(vType < V_Count);
+	PrimaryKeyFileMap& files = primaryKeyIndex[vType];
+	PrimaryKeyFileMap::iterator index = files.find(GetDataFileNum(dwID));
+	if (index != files.end())
+		index->second.RemoveRow(dwID, dwRowI);
+}
+
 //*****************************************************************************
 bool CDbBase::IsOpen()
 {
@@ -744,8 +887,8 @@ const WCHAR* CDbBase::GetMessageText(
 								//message.
 //
 //Returns:
-//Pointer to class buffer with message stored in it.  Buffer is cleared after each call
-//to GetMessageText.
+//Pointer to the message text.  Texts read from the DB are kept for the current language,
+//so the pointer stays valid until the message is changed or the DB is closed.
 {
 #ifdef PATCH
 	//Hard-code message texts that won't be in the expected .dat file when patching an older version.
@@ -804,18 +947,39 @@ const WCHAR* CDbBase::GetMessageText(
 
 	ASSERT(IsOpen());
 
+	//Return text already read for the current language.
+	const UINT language = Language::GetLanguage();
+	internedTextMap::const_iterator interned = internedTexts.find(eMessageID);
+	if (interned != internedTexts.end() && interned->second->language == language)
+	{
+		if (pdwLen) *pdwLen = interned->second->text.size();
+		return interned->second->text.c_str();
+	}
+
 	//Find message text.
 	const UINT dwFoundRowI = FindMessageText(eMessageID);
 	if (dwFoundRowI == ROW_NO_MATCH)
 	{
-		//Set last message to an empty string and return
 		if (pdwLen) *pdwLen=0;
-		return SetLastMessageText(wszEmpty, 0);
+		return wszEmpty;
 	}
 
-	//Set last message to retrieved message and return.
 	c4_Bytes MessageTextBytes = p_MessageText(GetRowRef(V_MessageTexts, dwFoundRowI));
-	return GetMessageText(MessageTextBytes, pdwLen);
+	UINT dwMessageTextLen = (MessageTextBytes.Size() - 1) / 2;
+	if (dwMessageTextLen >= MAXLEN_LARGE_BUF)
+		dwMessageTextLen = MAXLEN_SMALL_BUF;
+
+	forgetMessageText(eMessageID); //looked up in another language
+	InternedMessageText *pText = new InternedMessageText;
+	pText->language = language;
+	pText->text.assign((const WCHAR*)MessageTextBytes.Contents(), dwMessageTextLen);
+#if (GAME_BYTEORDER == GAME_BYTEORDER_BIG)
+	LittleToBig(&pText->text[0], dwMessageTextLen);
+#endif
+	internedTexts[eMessageID] = pText;
+
+	if (pdwLen) *pdwLen = dwMessageTextLen;
+	return pText->text.c_str();
 }
 
 //*****************************************************************************
@@ -831,7 +995,6 @@ const WCHAR* CDbBase::GetMessageText(
 	if (pdwLen) *pdwLen=dwMessageTextLen;
 
 	//Which buffer to use?  For speed try to use smaller buffer to avoid allocs.
-	static const UINT MAXLEN_SMALL_BUF = 500, MAXLEN_LARGE_BUF = 10000; //10k is unexpectedly large.
 	static WCHAR wzSmallBuf[MAXLEN_SMALL_BUF + 1];
 	WCHAR *pwzLargeBuf = NULL, *pwzUseBuf;
 	if (dwMessageTextLen > MAXLEN_SMALL_BUF)
@@ -979,6 +1142,7 @@ MESSAGE_ID CDbBase::AddMessageText(
 		rowIndex += previousViewSize;
 
 	addMessage(eMessageID, rowIndex);
+	forgetMessageText(eMessageID); //may now have a text in the current language
 
 #if (GAME_BYTEORDER == GAME_BYTEORDER_BIG)
 	delete[] pBytes;
@@ -1042,6 +1206,7 @@ MESSAGE_ID CDbBase::ChangeMessageText(
 	c4_Bytes MessageBytes(pBytes, (dwMessageLen + 1)*sizeof(WCHAR));
 	p_MessageText(row) = MessageBytes;
 	CDbBase::DirtyText();
+	forgetMessageText(eMessageID);
 
 #if (GAME_BYTEORDER == GAME_BYTEORDER_BIG)
 	delete[] pBytes;
@@ -1060,6 +1225,7 @@ void CDbBase::DeleteMessage(
 	//in order to reduce time rebuilding the row lookup index.
 	ASSERT(!messageIDsMarkedForDeletion.has(eMessageID));
 	messageIDsMarkedForDeletion += eMessageID;
+	forgetMessageText(eMessageID);
 	DirtyText();
 }
 
@@ -1092,7 +1258,9 @@ void CDbBase::DeleteMarkedMessages()
 					UINT(p_MessageID(GetRowRef(V_MessageTexts, *messageRow)))));
 
 			const UINT localRowIndex = globalRowToLocalRow(*messageRow, V_MessageTexts);
+			const UINT messageTextID = UINT(p_MessageTextID(MessageTextsView[localRowIndex]));
 			MessageTextsView.RemoveAt(localRowIndex);
+			removePrimaryKeyRow(messageTextID, V_MessageTexts, localRowIndex);
 		}
 	}
 
@@ -1478,9 +1646,12 @@ void CDbBase::deleteMessages(const CIDSet& messageIDs, const CIDSet& rowIDs)
 			message != messageIndex.end(); ++message)
 	{
 		//Correct row index for each messageTextID belonging to this messageID.
+		//Offsets never decrease with row index, so the corrected rows remain
+		//in the same order.
 		CIDSet& ids = message->second;
-		CIDSet::iterator messageTextRow = ids.begin();
-		while (messageTextRow != ids.end())
+		CIDSet shiftedRows;
+		for (CIDSet::const_iterator messageTextRow = ids.begin();
+				messageTextRow != ids.end(); ++messageTextRow)
 		{
 			//Tally how many rows before this row have been deleted.
 			const UINT oldRow = *messageTextRow;
@@ -1492,17 +1663,11 @@ void CDbBase::deleteMessages(const CIDSet& messageIDs, const CIDSet& rowIDs)
 					break; //no more rows before the old row have been deleted
 			}
 
-			if (rowOffset)
-			{
-				//We can replace a value in this set with a lower value this way.
-				messageTextRow = ids.erase(messageTextRow); //increments iterator
-				ASSERT(oldRow >= rowOffset);
-				ASSERT(!ids.has(oldRow - rowOffset)); //this row index shouldn't already be present in the set
-				ids += (oldRow - rowOffset);
-			} else {
-				++messageTextRow; //this messageText's row index has not changed
-			}
+			ASSERT(oldRow >= rowOffset);
+			ASSERT(!shiftedRows.has(oldRow - rowOffset)); //this row index shouldn't already be present in the set
+			shiftedRows += (oldRow - rowOffset);
 		}
+		ids = shiftedRows;
 	}
 }
 
@@ -1521,6 +1686,9 @@ CIDSet CDbBase::getMessageRows(const UINT messageID)
 void CDbBase::resetIndex()
 {
 	messageIndex.clear();
+	clearInternedTexts();
+	for (UINT vType = V_First; vType < V_Count; ++vType)
+		primaryKeyIndex[vType].clear();
 }
 
 //*****************************************************************************
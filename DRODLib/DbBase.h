@@ -109,6 +109,7 @@ protected:
 	CCoordSet           GetMessageTextIDs(const MESSAGE_ID dwMessageID) const;
 
 	static UINT         LookupRowByPrimaryKey(const UINT dwID, const VIEWTYPE vType, c4_View &View);
+	static void         removePrimaryKeyRow(const UINT dwID, const VIEWTYPE vType, const UINT dwRowI);
 
 	//Accelerated lookup index generation.
 	virtual void resetIndex();
@@ -124,6 +125,7 @@ private:
 	void          Undirty();
 	void          ResetStorage();
 
+	static UINT       GetDataFileNum(const UINT dwID);
 	static c4_ViewRef GetPlayerDataView(const VIEWTYPE vType, const char* viewName);
 
 	static void   addMessage(const UINT messageID, const UINT messageRow);
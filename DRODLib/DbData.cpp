@@ -113,6 +113,7 @@ void CDbData::Delete(
 		return; //dangling ID reference
 
 	DataView.RemoveAt(dwDataRowI);
+	removePrimaryKeyRow(dwDataID, V_Data, dwDataRowI);
 	CDb::deleteData(dwDataID);
 
 	//After object is deleted, membership might change, so reset the flag.
@@ -81,6 +81,7 @@ void CDbDemos::Delete(
 
 	//Delete the demo.
 	DemosView.RemoveAt(dwDemoRowI);
+	removePrimaryKeyRow(dwDemoID, V_Demos, dwDemoRowI);
 
 	//Update any record that had this one as its next demo.
 	const UINT dwDemoCount = GetViewSize();
@@ -1090,6 +1091,7 @@ MESSAGE_ID CDbDemo::SetProperty(
 					//This one belongs to a saved game for a room not in the current
 					//data files and must be taken back out of the DB.
 					DemosView.RemoveAt(dwDemoRowI);
+					removePrimaryKeyRow(this->dwDemoID, V_Demos, dwDemoRowI);
 				}
 				bSaveRecord = false;
 			}
@@ -147,6 +147,7 @@ void CDbHolds::Delete(
 	//Delete the hold.
 	CDb::deleteHold(dwHoldID); //call first
 	HoldsView.RemoveAt(dwHoldRowI);
+	removePrimaryKeyRow(dwHoldID, V_Holds, dwHoldRowI);
 	}
 	END_DBREFCOUNT_CHECK;
 
@@ -1179,7 +1180,7 @@ void CDbHolds::GetRoomsExplored(
 	}
 
 	//Total rooms explored/conquered for this hold.
-	const UINT savedGameID = db.SavedGames.FindByType(ST_PlayerTotal, dwPlayerID, false);
+	const UINT savedGameID = CDb::getPlayerTotalSavedGame(dwPlayerID);
 	if (savedGameID)
 	{
 		CIDSet roomsInHold = CDb::getRoomsInHold(dwHoldID);
@@ -1228,7 +1229,7 @@ void CDbHolds::GetRoomsExplored(
 	}
 
 	//Total rooms explored/conquered for this hold.
-	const UINT savedGameID = db.SavedGames.FindByType(ST_PlayerTotal, dwPlayerID, false);
+	const UINT savedGameID = CDb::getPlayerTotalSavedGame(dwPlayerID);
 	if (savedGameID)
 	{
 		CIDSet roomsInHold = CDb::getRoomsInHold(dwHoldID);
@@ -1261,15 +1262,10 @@ const
 	//Total rooms explored/conquered for this hold.
 	CIDSet roomsExplored;
 	CDb db;
-	const UINT savedGameID = db.SavedGames.FindByType(ST_PlayerTotal, dwPlayerID, false);
+	const UINT savedGameID = CDb::getPlayerTotalSavedGame(dwPlayerID);
 	if (savedGameID)
 	{
-		if (bConqueredOnly)
-		{
-			roomsExplored = db.SavedGames.GetConqueredRooms(savedGameID);
-		} else {
-			roomsExplored = db.SavedGames.GetExploredRooms(savedGameID);
-		}
+		roomsExplored = CDb::getPlayerTotalRooms(dwPlayerID, bConqueredOnly);
 		roomsExplored.intersect(stats.secretRooms); //filter by secret rooms in hold
 		return roomsExplored.size();
 	}
@@ -1967,6 +1963,31 @@ bool CDbHold::ChangeAuthor(
    return Update();
 }
 
+//*****************************************************************************
+void CDbHold::ClearCharacters()
+//Deletes all custom characters.
+{
+	for (vector<HoldCharacter*>::iterator chIt=this->characters.begin();
+			chIt!=this->characters.end(); ++chIt)
+		delete *chIt;
+	this->characters.clear();
+}
+
+//*****************************************************************************
+void CDbHold::CopyCharacters(
+//Adds copies of another hold's custom characters.
+//
+//Params:
+	const CDbHold& Src,         //(in)
+	const bool bCopyLocalInfo)  //(in) keep the characters' IDs in the DB [default=true]
+{
+	for (vector<HoldCharacter*>::const_iterator chIter = Src.characters.begin();
+			chIter != Src.characters.end(); ++chIter)
+	{
+		this->characters.push_back(new HoldCharacter(*(*chIter), !bCopyLocalInfo));
+	}
+}
+
 //*****************************************************************************
 bool CDbHold::DeleteEntrance(CEntranceData *pEntrance)   //(in/out) deleted on return
 //Delete this entrance.
@@ -3169,7 +3190,8 @@ bool CDbHold::SetMembers(
 //
 //Params:
 	const CDbHold &Src,
-	const bool bCopyLocalInfo) //(in) default = true
+	const bool bCopyLocalInfo,  //(in) default = true
+	const bool bCopyCharacters) //(in) if false, custom characters are left out [default=true]
 {
 	//Retain prior IDs, if requested.
 	if (!bCopyLocalInfo)
@@ -3223,11 +3245,8 @@ bool CDbHold::SetMembers(
 	this->vars = Src.vars;
 	this->localScriptVars = Src.localScriptVars;
 	this->worldMaps = Src.worldMaps;
-	for (vector<HoldCharacter*>::const_iterator chIter = Src.characters.begin();
-			chIter != Src.characters.end(); ++chIter)
-	{
-		this->characters.push_back(new HoldCharacter(*(*chIter), !bCopyLocalInfo));
-	}
+	if (bCopyCharacters)
+		CopyCharacters(Src, bCopyLocalInfo);
 
 	return true;
 }
@@ -4115,10 +4134,7 @@ void CDbHold::Clear()
 	this->vars.clear();
 	this->localScriptVars.clear();
 
-	for (vector<HoldCharacter*>::iterator chIt=this->characters.begin();
-			chIt!=this->characters.end(); ++chIt)
-		delete *chIt;
-	this->characters.clear();
+	ClearCharacters();
 
 	this->worldMaps.clear();
 
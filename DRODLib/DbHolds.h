@@ -58,7 +58,7 @@ protected:
 	void CopyHoldMedia(CDbHold *pNewHold, CImportInfo& info);
 
 public:
-	CDbHold(CDbHold &Src) : CDbBase() {SetMembers(Src);}
+	CDbHold(CDbHold &Src, const bool bCopyCharacters=true) : CDbBase() {SetMembers(Src, true, bCopyCharacters);}
 	CDbHold &operator= (const CDbHold &Src) {
 		SetMembers(Src);
 		return *this;
@@ -84,6 +84,8 @@ public:
 	UINT        AddVar(const WCHAR* pwszName);
 	UINT        AddWorldMap(const WCHAR* pwszName);
 	bool        ChangeAuthor(const UINT dwNewAuthorID);
+	void        ClearCharacters();
+	void        CopyCharacters(const CDbHold& Src, const bool bCopyLocalInfo=true);
 	void        CopyCustomCharacterData(HoldCharacter& ch, CDbHold *pNewHold, CImportInfo& info) const;
 	bool        DeleteCharacter(const UINT dwCharID);
 	bool        DeleteEntrance(CEntranceData *pEntrance);
@@ -189,7 +191,8 @@ private:
 	void     SaveEntrances(c4_View& EntrancesView);
 	void     SaveVars(c4_View& VarsView);
 	void     SaveWorldMaps(c4_View& WorldMapsView);
-	bool     SetMembers(const CDbHold& Src, const bool bCopyLocalInfo=true);
+	bool     SetMembers(const CDbHold& Src, const bool bCopyLocalInfo=true,
+			const bool bCopyCharacters=true);
 	bool     UpdateExisting();
 	bool     UpdateNew();
 
@@ -85,6 +85,7 @@ void CDbLevels::Delete(
 	//Delete the level.
 	CDb::deleteLevel(dwLevelID); //call first
 	LevelsView.RemoveAt(dwLevelRowI);
+	removePrimaryKeyRow(dwLevelID, V_Levels, dwLevelRowI);
 
 	//After level object is deleted, membership might change, so reset the flag.
 	this->bIsMembershipLoaded = false;
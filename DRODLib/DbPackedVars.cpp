@@ -34,6 +34,39 @@
 #include <BackEndLib/StretchyBuffer.h>
 #include <BackEndLib/Ports.h>
 
+#include <algorithm>
+
+//Hold vars with larger IDs are kept in the name map.
+const UINT MAX_SLOT_VAR_ID = 0xFFFF;
+
+inline bool IsSlotVarID(const UINT dwVarID) {return dwVarID && dwVarID <= MAX_SLOT_VAR_ID;}
+
+//Value of slotIter when GetNext should not return any slots.
+const UINT NO_SLOT_ITER = UINT(-1);
+
+//*******************************************************************************************
+static void PackVar(
+//Appends one var to a packed var buffer.
+//
+//Params:
+	CStretchyBuffer &PackedBuf,   //(in/out)
+	const string &name, const UNPACKEDVARTYPE eType, //(in)
+	const void *pValue, const UINT dwValueSize)      //(in)
+{
+	PackedBuf += (UINT) name.size() + 1;
+	PackedBuf += name.c_str();
+	PackedBuf += (BYTE)0; //null terminate var name
+
+	//Store variable type.
+	PackedBuf += static_cast<int>(eType);
+
+	//Store variable data size.
+	PackedBuf += dwValueSize;
+
+	//Store variable data.
+	PackedBuf.Append((const BYTE *) pValue, dwValueSize);
+}
+
 //
 //Public methods.
 //
@@ -44,7 +77,7 @@ CDbPackedVars::CDbPackedVars(
 //
 //Params:
 	const BYTE *pBuf) //(in) Buffer containing packed variables.
-	: bOldFormat(false)
+	: slotIterVar(""), bOldFormat(false)
 {
 	UnpackBuffer(pBuf, 1);
 }
@@ -59,7 +92,7 @@ CDbPackedVars::~CDbPackedVars()
 //*******************************************************************************************
 CDbPackedVars::CDbPackedVars(const CDbPackedVars& Src)
 //Copy constructor.
-	: bOldFormat(false)
+	: slotIterVar(""), bOldFormat(false)
 {
 	SetMembers(Src);
 }
@@ -74,6 +107,12 @@ void CDbPackedVars::Clear()
 	this->vars.clear();
 	this->varIter = this->vars.end();
 	this->lastQueryIter = this->vars.end();
+
+	this->slots.clear();
+	this->slotTexts.clear();
+	this->slotIter = NO_SLOT_ITER;
+	this->slotIterVar.pValue = NULL; //not owned
+	this->wHoldVarsInMap = 0;
 }
 
 //*******************************************************************************************
@@ -81,15 +120,34 @@ UNPACKEDVAR* CDbPackedVars::GetFirst()
 //API to retrieve the first var in the set.
 {
 	this->varIter = this->vars.begin();
+	this->slotIter = 0;
 	return GetNext();
 }
 
 //*******************************************************************************************
 UNPACKEDVAR* CDbPackedVars::GetNext()
+//Vars in the name map are returned first, followed by hold vars in the slot table.
+//A returned slot var is valid only until the next call.
 {
-	if (this->varIter == this->vars.end())
-		return NULL;
-	return (this->varIter++)->second;
+	if (this->varIter != this->vars.end())
+		return (this->varIter++)->second;
+
+	while (this->slotIter < this->slots.size())
+	{
+		const UINT dwVarID = this->slotIter++;
+		UINT dwValueSize;
+		const void *pValue = GetSlotValue(dwVarID, dwValueSize);
+		if (!pValue)
+			continue;
+
+		this->slotIterVar.name = GetSlotVarName(dwVarID);
+		this->slotIterVar.pValue = const_cast<void*>(pValue);
+		this->slotIterVar.dwValueSize = dwValueSize;
+		this->slotIterVar.eType = this->slots[dwVarID].eType;
+		return &this->slotIterVar;
+	}
+
+	return NULL;
 }
 
 //*******************************************************************************************
@@ -104,14 +162,19 @@ void CDbPackedVars::SetMembers(const CDbPackedVars &Src)
 		UNPACKEDVAR *pSrcVar = i->second;
 		SetVar(pSrcVar->name.c_str(), pSrcVar->pValue, pSrcVar->dwValueSize, pSrcVar->eType);
 	}
+
+	this->slots = Src.slots;
+	this->slotTexts = Src.slotTexts;
 }
 
 //*******************************************************************************************
 void CDbPackedVars::Unset(const char *pszVarName)
 {
-	this->vars.erase(pszVarName);
+	UnsetSlot(GetSlotID(pszVarName));
+	RemoveVar(pszVarName);
 
 	this->varIter = this->vars.end(); //invalidate
+	this->slotIter = NO_SLOT_ITER;
 }
 
 //*******************************************************************************************
@@ -126,6 +189,12 @@ void * CDbPackedVars::GetVar(
 //Returns:
 //Pointer to variable value.
 {
+	//Hold var in the slot table?
+	UINT dwValueSize;
+	const void *pSlotValue = GetSlotValue(GetSlotID(pszVarName), dwValueSize);
+	if (pSlotValue)
+		return const_cast<void*>(pSlotValue);
+
 	//Find var with matching name.
 	const UNPACKEDVAR *pFoundVar = FindVarByName(pszVarName);
 	if (pFoundVar)
@@ -263,6 +332,16 @@ void* CDbPackedVars::SetVar(
 {
 	bool bSuccess = true;
 
+	//Hold vars of supported types are kept in the slot table.
+	const UINT dwVarID = GetSlotID(pszVarName);
+	if (dwVarID)
+	{
+		UINT dwSlotValueSize;
+		if (SetSlot(dwVarID, pValue, dwValueSize, eSetType))
+			return const_cast<void*>(GetSlotValue(dwVarID, dwSlotValueSize));
+		UnsetSlot(dwVarID);
+	}
+
 	//Try to get an existing unpacked var with matching name,
 	UNPACKEDVAR *pVar = FindVarByName(pszVarName);
 	if (!pVar) //No existing var of same name.
@@ -270,6 +349,8 @@ void* CDbPackedVars::SetVar(
 		//Create new var and add to list.
 		pVar = new UNPACKEDVAR(pszVarName, NULL, 0, eSetType);
 		this->vars[pVar->name] = pVar;
+		if (dwVarID)
+			++this->wHoldVarsInMap;
 	}
 
 	//Set value of var.
@@ -302,23 +383,31 @@ const
 {
 	CStretchyBuffer PackedBuf;
 
+	//Vars are packed in name order, so hold vars in the slot table are merged in
+	//among the vars in the name map by name, not by ID ("v10" precedes "v9").
+	typedef std::pair<string, UINT> SlotVarName;
+	std::vector<SlotVarName> slotVars;
+	for (UINT dwVarID = 1; dwVarID < this->slots.size(); ++dwVarID)
+		if (FindSlot(dwVarID))
+			slotVars.push_back(SlotVarName(GetSlotVarName(dwVarID), dwVarID));
+	std::sort(slotVars.begin(), slotVars.end());
+
 	//Each iteration packs one var into buffer.
-	for (std::map <string, UNPACKEDVAR*>::const_iterator i = this->vars.begin();
-			i != this->vars.end();	++i)
+	std::map <string, UNPACKEDVAR*>::const_iterator i = this->vars.begin();
+	std::vector<SlotVarName>::const_iterator slotVar = slotVars.begin();
+	while (i != this->vars.end() || slotVar != slotVars.end())
 	{
-		UNPACKEDVAR *pReadVar = i->second;
-		PackedBuf += (UINT) pReadVar->name.size() + 1;
-		PackedBuf += pReadVar->name.c_str();
-		PackedBuf += (BYTE)0; //null terminate var name
-
-		//Store variable type.
-		PackedBuf += static_cast<int>(pReadVar->eType);
-
-		//Store variable data size.
-		PackedBuf += pReadVar->dwValueSize;
-
-		//Store variable data.
-		PackedBuf.Append((const BYTE *) pReadVar->pValue, pReadVar->dwValueSize);    
+		if (slotVar == slotVars.end() || (i != this->vars.end() && i->first < slotVar->first))
+		{
+			UNPACKEDVAR *pReadVar = i->second;
+			PackVar(PackedBuf, pReadVar->name, pReadVar->eType, pReadVar->pValue, pReadVar->dwValueSize);
+			++i;
+		} else {
+			UINT dwValueSize;
+			const void *pValue = GetSlotValue(slotVar->second, dwValueSize);
+			PackVar(PackedBuf, slotVar->first, this->slots[slotVar->second].eType, pValue, dwValueSize);
+			++slotVar;
+		}
 	}
 
 	//Append end code to buffer.
@@ -331,6 +420,10 @@ const
 UNPACKEDVARTYPE CDbPackedVars::GetVarType(const char *pszVarName) const
 //Returns: type of var, or UVT_unknown if no match
 {
+	const PACKEDVARSLOT *pSlot = FindSlotByName(pszVarName);
+	if (pSlot)
+		return pSlot->eType;
+
 	UNPACKEDVAR *pVar = FindVarByName(pszVarName);
 	return pVar ? pVar->eType : UVT_unknown;
 }
@@ -346,6 +439,10 @@ const
 //Returns:
 //The size or 0 if no match.
 {
+	UINT dwValueSize;
+	if (GetSlotValue(GetSlotID(pszVarName), dwValueSize))
+		return dwValueSize;
+
 	//Since this method is called only following a successful call to FindVarByName,
 	//which sets the query iterator, now rewind the increment on this iterator
 	//so the find operation below may be performed quickly.
@@ -355,6 +452,91 @@ const
 	return pVar ? pVar->dwValueSize : 0;
 }
 
+//*******************************************************************************************
+UNPACKEDVARTYPE CDbPackedVars::GetHoldVarType(const UINT dwVarID) const
+//Returns: type of hold var with this ID, or UVT_unknown if it is not set
+{
+	const PACKEDVARSLOT *pSlot = FindSlot(dwVarID);
+	if (pSlot)
+		return pSlot->eType;
+	if (!IsHoldVarStoredByName(dwVarID))
+		return UVT_unknown;
+	return GetVarType(GetSlotVarName(dwVarID).c_str());
+}
+
+//*******************************************************************************************
+int CDbPackedVars::GetHoldVarInt(
+//Returns: integer value of hold var with this ID
+//
+//Params:
+	const UINT dwVarID,       //(in)
+	int nNotFoundValue)       //(in) returned if var is not set [default=0]
+const
+{
+	const PACKEDVARSLOT *pSlot = FindSlot(dwVarID);
+	if (pSlot && pSlot->eType != UVT_wchar_string)
+	{
+		UINT wRet(pSlot->value);
+#if (GAME_BYTEORDER == GAME_BYTEORDER_BIG)
+		LittleToBig(&wRet);
+#endif
+		return int(wRet);
+	}
+	if (!pSlot && !IsHoldVarStoredByName(dwVarID))
+		return nNotFoundValue;
+	return GetVar(GetSlotVarName(dwVarID).c_str(), nNotFoundValue);
+}
+
+//*******************************************************************************************
+const WCHAR* CDbPackedVars::GetHoldVarText(
+//Returns: text value of hold var with this ID
+//
+//Params:
+	const UINT dwVarID,                //(in)
+	const WCHAR *pwczNotFoundValue)    //(in) returned if var is not set [default=NULL]
+const
+{
+#if (GAME_BYTEORDER != GAME_BYTEORDER_BIG)
+	const PACKEDVARSLOT *pSlot = FindSlot(dwVarID);
+	if (pSlot && pSlot->eType == UVT_wchar_string)
+		return this->slotTexts.find(dwVarID)->second.c_str();
+	if (!pSlot && !IsHoldVarStoredByName(dwVarID))
+		return pwczNotFoundValue;
+#endif
+	//Other types, or text needing byte order conversion.
+	return GetVar(GetSlotVarName(dwVarID).c_str(), pwczNotFoundValue);
+}
+
+//*******************************************************************************************
+void CDbPackedVars::SetHoldVar(const UINT dwVarID, int nValue)
+//Sets hold var with this ID to an integer value.
+{
+	if (!IsSlotVarID(dwVarID))
+	{
+		SetVar(GetSlotVarName(dwVarID).c_str(), nValue);
+		return;
+	}
+
+#if (GAME_BYTEORDER == GAME_BYTEORDER_BIG)
+	LittleToBig((UINT*)&nValue);
+#endif
+	SetSlot(dwVarID, &nValue, sizeof(nValue), UVT_int);
+}
+
+//*******************************************************************************************
+void CDbPackedVars::SetHoldVar(const UINT dwVarID, const WCHAR *pwczValue)
+//Sets hold var with this ID to a text value.
+{
+	ASSERT(pwczValue);
+	if (!IsSlotVarID(dwVarID) || GAME_BYTEORDER == GAME_BYTEORDER_BIG)
+	{
+		SetVar(GetSlotVarName(dwVarID).c_str(), pwczValue);
+		return;
+	}
+
+	SetSlot(dwVarID, pwczValue, (WCSlen(pwczValue)+1)*sizeof(WCHAR), UVT_wchar_string);
+}
+
 //
 //Private methods.
 //
@@ -436,7 +618,20 @@ bool CDbPackedVars::UnpackBuffer(
 		memcpy(pNewVar->pValue, pRead, pNewVar->dwValueSize);
 		pRead += pNewVar->dwValueSize;
 
-		this->vars[pNewVar->name] = pNewVar;
+		//Hold vars of supported types go in the slot table.
+		const UINT dwVarID = GetSlotID(pNewVar->name.c_str());
+		if (dwVarID && SetSlot(dwVarID, pNewVar->pValue, pNewVar->dwValueSize, pNewVar->eType))
+			delete pNewVar;
+		else {
+			if (dwVarID)
+			{
+				UnsetSlot(dwVarID);
+				if (!this->vars.count(pNewVar->name))
+					++this->wHoldVarsInMap;
+			}
+			this->vars[pNewVar->name] = pNewVar;
+		}
+		pNewVar = NULL;
 
 		//Get size of next variable name or end code.
 		memcpy(&wVarNameSize, pRead, sizeof(UINT));
@@ -518,3 +713,170 @@ UNPACKEDVARTYPE CDbPackedVars::Get1_6VarType(const char *pszVarName) const
 
    return UVT_unknown;
 }
+
+//*******************************************************************************************
+UINT CDbPackedVars::GetSlotID(const char *pszVarName)
+//Returns: ID of a var named "v<ID>" that may be kept in the slot table, or 0 if the name
+//is not of this form
+{
+	ASSERT(pszVarName);
+	if (pszVarName[0] != 'v' || pszVarName[1] < '1' || pszVarName[1] > '9')
+		return 0;
+
+	UINT dwVarID = 0;
+	for (const char *pos = pszVarName + 1; *pos; ++pos)
+	{
+		if (*pos < '0' || *pos > '9')
+			return 0;
+		dwVarID = dwVarID * 10 + (*pos - '0');
+		if (dwVarID > MAX_SLOT_VAR_ID)
+			return 0;
+	}
+	return dwVarID;
+}
+
+//*******************************************************************************************
+string CDbPackedVars::GetSlotVarName(const UINT dwVarID)
+//Returns: name of hold var with this ID, as in CDbHold::getVarAccessToken
+{
+	char varName[12] = "v";
+	_itoa(dwVarID, varName + 1, 10);
+	return string(varName);
+}
+
+//*******************************************************************************************
+const PACKEDVARSLOT* CDbPackedVars::FindSlot(const UINT dwVarID) const
+//Returns: the slot holding the value of this hold var, or NULL if it is not in the table
+{
+	if (!dwVarID || dwVarID >= this->slots.size())
+		return NULL;
+	const PACKEDVARSLOT& slot = this->slots[dwVarID];
+	return slot.eType != UVT_unknown ? &slot : NULL;
+}
+
+//*******************************************************************************************
+const PACKEDVARSLOT* CDbPackedVars::FindSlotByName(const char *pszVarName) const
+{
+	return FindSlot(GetSlotID(pszVarName));
+}
+
+//*******************************************************************************************
+const void* CDbPackedVars::GetSlotValue(
+//Returns: pointer to packed value of hold var in the slot table, or NULL if it is not there
+//
+//Params:
+	const UINT dwVarID,  //(in)
+	UINT &dwValueSize)   //(out) size of value
+const
+{
+	const PACKEDVARSLOT *pSlot = FindSlot(dwVarID);
+	if (!pSlot)
+		return NULL;
+
+	if (pSlot->eType == UVT_wchar_string)
+	{
+		std::map<UINT, WSTRING>::const_iterator text = this->slotTexts.find(dwVarID);
+		ASSERT(text != this->slotTexts.end());
+		dwValueSize = (text->second.size() + 1) * sizeof(WCHAR);
+		return text->second.c_str();
+	}
+
+	dwValueSize = sizeof(pSlot->value);
+	return &pSlot->value;
+}
+
+//*******************************************************************************************
+bool CDbPackedVars::IsHoldVarStoredByName(const UINT dwVarID) const
+//Returns: whether a hold var not in the slot table might still be set in the name map
+{
+	return !IsSlotVarID(dwVarID) || this->wHoldVarsInMap;
+}
+
+//*******************************************************************************************
+void CDbPackedVars::RemoveVar(const char *pszVarName)
+//Removes var from the name map.
+{
+	std::map <string, UNPACKEDVAR*>::iterator var = this->vars.find(pszVarName);
+	if (var == this->vars.end())
+		return;
+
+	if (this->varIter == var)
+		++this->varIter;
+	this->lastQueryIter = this->vars.end();
+
+	if (GetSlotID(pszVarName))
+	{
+		ASSERT(this->wHoldVarsInMap);
+		--this->wHoldVarsInMap;
+	}
+	delete var->second;
+	this->vars.erase(var);
+}
+
+//*******************************************************************************************
+bool CDbPackedVars::SetSlot(
+//Stores value of hold var in the slot table.
+//
+//Returns: true if the value was stored, false if the var's type is not kept in the table
+//
+//Params:
+	const UINT dwVarID,        //(in)
+	const void *pValue,        //(in) packed value
+	UINT dwValueSize,          //(in)
+	const UNPACKEDVARTYPE eType) //(in)
+{
+	if (!IsSlotVarID(dwVarID))
+		return false;
+
+	const UINT wChars = dwValueSize / sizeof(WCHAR);
+	switch (eType)
+	{
+		case UVT_int:
+		case UVT_uint:
+			if (dwValueSize != sizeof(UINT))
+				return false;
+		break;
+		case UVT_wchar_string:
+		{
+			//Must be a null-terminated string.
+			static const WCHAR wcNull = 0;
+			if (!wChars || dwValueSize % sizeof(WCHAR) ||
+					memcmp((const BYTE*)pValue + dwValueSize - sizeof(WCHAR), &wcNull, sizeof(WCHAR)))
+				return false;
+		}
+		break;
+		default: return false;
+	}
+
+	if (dwVarID >= this->slots.size())
+		this->slots.resize(dwVarID + 1);
+	PACKEDVARSLOT& slot = this->slots[dwVarID];
+
+	//A var is kept in either the slot table or the name map, not both.
+	if (slot.eType == UVT_unknown && this->wHoldVarsInMap)
+		RemoveVar(GetSlotVarName(dwVarID).c_str());
+
+	if (eType == UVT_wchar_string)
+	{
+		this->slotTexts[dwVarID].assign((const WCHAR*)pValue, wChars - 1);
+		slot.value = 0;
+	} else {
+		if (slot.eType == UVT_wchar_string)
+			this->slotTexts.erase(dwVarID);
+		memcpy(&slot.value, pValue, sizeof(slot.value));
+	}
+	slot.eType = eType;
+	return true;
+}
+
+//*******************************************************************************************
+void CDbPackedVars::UnsetSlot(const UINT dwVarID)
+//Removes hold var from the slot table.
+{
+	if (!dwVarID || dwVarID >= this->slots.size())
+		return;
+	PACKEDVARSLOT& slot = this->slots[dwVarID];
+	if (slot.eType == UVT_wchar_string)
+		this->slotTexts.erase(dwVarID);
+	slot = PACKEDVARSLOT();
+}
@@ -44,6 +44,11 @@
 //where your calling code is starting from you may wish to use the "const byte *" or
 //"c4_BytesRef &" assignment operators.  Unpacking the byte buffer will result in the
 //variables that were stored in the buffer to become accessible through the class methods.
+//
+//Vars named "v<ID>" (hold vars, see CDbHold::getVarAccessToken) holding an int, UINT or
+//WCHAR string are not kept in the name map, but in a table indexed by ID.  They may be
+//accessed by name like any other var, or directly by ID through the *HoldVar* methods,
+//which avoids formatting and searching for the name.  Copying the table is a flat copy.
 
 #ifndef DBPACKEDVARS_H
 #define DBPACKEDVARS_H
@@ -55,6 +60,7 @@
 
 #include <cstring>
 #include <map>
+#include <vector>
 
 #include <mk4.h>
 
@@ -88,10 +94,18 @@ struct UNPACKEDVAR
 	UNPACKEDVARTYPE eType;
 };
 
+//A hold var kept in CDbPackedVars' ID-indexed table.
+struct PACKEDVARSLOT
+{
+	PACKEDVARSLOT() : eType(UVT_unknown), value(0) {}
+	UNPACKEDVARTYPE eType; //UVT_int, UVT_uint or UVT_wchar_string when set, otherwise UVT_unknown
+	UINT value;            //int or UINT value, in packed byte order
+};
+
 class CDbPackedVars
 {
 public:
-	CDbPackedVars() : bOldFormat(false) {Clear();}
+	CDbPackedVars() : slotIterVar(""), bOldFormat(false) {Clear();}
 	CDbPackedVars(const CDbPackedVars& Src);
 	CDbPackedVars(const BYTE *pBuf);
 	~CDbPackedVars();
@@ -114,7 +128,7 @@ public:
 	void        Clear();
 	bool        DoesVarExist(const char *pszVarName)
 	{
-		return FindVarByName(pszVarName)!=NULL;
+		return FindSlotByName(pszVarName)!=NULL || FindVarByName(pszVarName)!=NULL;
 	}
 	UNPACKEDVAR*   GetFirst();
 	UNPACKEDVAR*   GetNext();
@@ -135,6 +149,13 @@ public:
 
 	void			UseOldFormat(const bool bVal=true) {this->bOldFormat = bVal;}
 
+	//Hold var access by ID.
+	UNPACKEDVARTYPE GetHoldVarType(const UINT dwVarID) const;
+	int            GetHoldVarInt(const UINT dwVarID, int nNotFoundValue = 0) const;
+	const WCHAR *  GetHoldVarText(const UINT dwVarID, const WCHAR *pwczNotFoundValue = NULL) const;
+	void           SetHoldVar(const UINT dwVarID, int nValue);
+	void           SetHoldVar(const UINT dwVarID, const WCHAR *pwczValue);
+
 	void *         SetVar(const char *pszVarName, const void *pValue, UINT dwValueSize, const UNPACKEDVARTYPE eType);
 	char *         SetVar(const char *pszVarName, const char *pszValue)
 	{
@@ -189,9 +210,26 @@ private:
 	UNPACKEDVAR *   FindVarByName(const char *pszVarName) const;
 	bool            UnpackBuffer(const BYTE *pBuf, const UINT bufSize);
 
+	static UINT     GetSlotID(const char *pszVarName);
+	static string   GetSlotVarName(const UINT dwVarID);
+	const PACKEDVARSLOT* FindSlot(const UINT dwVarID) const;
+	const PACKEDVARSLOT* FindSlotByName(const char *pszVarName) const;
+	const void *    GetSlotValue(const UINT dwVarID, UINT &dwValueSize) const;
+	bool            IsHoldVarStoredByName(const UINT dwVarID) const;
+	void            RemoveVar(const char *pszVarName);
+	bool            SetSlot(const UINT dwVarID, const void *pValue, UINT dwValueSize, const UNPACKEDVARTYPE eType);
+	void            UnsetSlot(const UINT dwVarID);
+
 	std::map <string, UNPACKEDVAR*> vars;
 	std::map <string, UNPACKEDVAR*>::iterator varIter;
 	mutable std::map <string, UNPACKEDVAR*>::const_iterator lastQueryIter;
+
+	std::vector<PACKEDVARSLOT> slots;  //hold vars, indexed by ID
+	std::map<UINT, WSTRING> slotTexts; //values of string hold vars, in packed byte order
+	UINT slotIter;              //GetFirst/GetNext position in slots
+	UNPACKEDVAR slotIterVar;    //view of the slot returned by GetNext
+	UINT wHoldVarsInMap;        //number of "v<ID>" vars of other types kept in the name map
+
 	bool bOldFormat;	//indicates newer eType var field should be ignored
 };
 
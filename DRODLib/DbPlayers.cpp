@@ -124,6 +124,7 @@ void CDbPlayers::Delete(
 	{
 		//Delete the player.
 		PlayersView.RemoveAt(dwPlayerI);
+		removePrimaryKeyRow(dwPlayerID, V_Players, dwPlayerI);
 	} else {
 		//Hide the player record.
 		p_IsLocal(row) = false;
@@ -78,6 +78,39 @@ ROOMCOORD      importCheckpoint;
 
 CCoordSet CDbRoom::debugMarkedTiles;
 
+//
+//RoomMapTiles methods.
+//
+
+//*****************************************************************************
+void RoomMapTiles::Set(
+//Copies a room's map data.
+//
+//Params:
+	const CDbRoom& room,   //(in) room with tiles loaded, if bWithTiles is set
+	const bool bWithTiles) //(in) [default=true] whether to copy tile data
+{
+	this->dwRoomID = room.dwRoomID;
+	this->dwRoomX = room.dwRoomX;
+	this->dwRoomY = room.dwRoomY;
+	this->bIsRequired = room.bIsRequired;
+	this->bIsSecret = room.bIsSecret;
+
+	this->oTiles.clear();
+	this->tTiles.clear();
+	if (!bWithTiles)
+		return;
+
+	const UINT dwSquareCount = room.CalcRoomArea();
+	this->oTiles.resize(dwSquareCount);
+	this->tTiles.resize(dwSquareCount);
+	for (UINT wSquareIndex=0; wSquareIndex<dwSquareCount; ++wSquareIndex)
+	{
+		this->oTiles[wSquareIndex] = (BYTE)room.pszOSquares[wSquareIndex];
+		this->tTiles[wSquareIndex] = (BYTE)room.GetTSquare(wSquareIndex);
+	}
+}
+
 //
 //CDbRooms public methods.
 //
@@ -98,6 +131,8 @@ void CDbRooms::Delete(
 
 	c4_RowRef row = RoomsView[dwRoomRowI];
 
+	ResetMapTiles(dwRoomID);
+
 	//Delete all scroll messages in room.
 	c4_View ScrollsView = p_Scrolls(row);
 	for (UINT wScrollI = ScrollsView.GetSize(); wScrollI--; )
@@ -150,6 +185,7 @@ void CDbRooms::Delete(
 	//Delete the room.
 	CDb::deleteRoom(dwRoomID); //call first
 	RoomsView.RemoveAt(dwRoomRowI);
+	removePrimaryKeyRow(dwRoomID, V_Rooms, dwRoomRowI);
 
 	//After room object is deleted, membership might change, so reset the flag.
 	this->bIsMembershipLoaded = false;
@@ -677,6 +713,50 @@ CDbRoom* CDbRooms::GetNew()
 	return pRoom;
 }
 
+//*****************************************************************************
+const RoomMapTiles* CDbRooms::GetMapTiles(
+//Gets what is needed to draw a room on the level map, without loading the rest
+//of the room.  The result is cached until the room is next saved or deleted.
+//
+//Returns: pointer to the room's map data, or NULL if the room doesn't exist
+//
+//Params:
+	const UINT dwRoomID,   //(in) room
+	const bool bWithTiles) //(in) [default=true] whether tile data is needed,
+	                       //or only the room's coords and flags
+{
+	std::map<UINT, RoomMapTiles>::iterator found = this->mapTiles.find(dwRoomID);
+	if (found != this->mapTiles.end() && (!bWithTiles || found->second.HasTiles()))
+		return &found->second;
+
+	CDbRoom *pRoom = GetByID(dwRoomID, true);
+	if (!pRoom)
+		return NULL;
+	if (bWithTiles && !pRoom->LoadTiles())
+	{
+		delete pRoom;
+		return NULL;
+	}
+
+	RoomMapTiles& tiles = this->mapTiles[dwRoomID];
+	tiles.Set(*pRoom, bWithTiles);
+	delete pRoom;
+	return &tiles;
+}
+
+//*****************************************************************************
+void CDbRooms::ResetMapTiles(
+//Discards cached map data when a room changes.
+//
+//Params:
+	const UINT dwRoomID) //(in) [default=0] room, or 0 for all rooms
+{
+	if (dwRoomID)
+		this->mapTiles.erase(dwRoomID);
+	else
+		this->mapTiles.clear();
+}
+
 //*****************************************************************************
 void CDbRooms::FilterBy(
 //Changes filter so that GetFirst() and GetNext() will return rooms for a
@@ -3358,6 +3438,9 @@ CMonster* CDbRoom::MonsterOfTypeExists(
 	const UINT eType) //(in) monster type
 const
 {
+	if (!IsValidMonsterType(eType) || !this->monsterTypeCounts[eType])
+		return NULL;
+
 	for (CMonster *pMonster = this->pFirstMonster; pMonster != NULL; pMonster = pMonster->pNext)
 		if (pMonster->wType == eType)
 			return pMonster;
@@ -3532,6 +3615,8 @@ void CDbRoom::LinkMonster(
 		default: break;
 	}
 
+	CountMonsterType(pMonster, true);
+
 	if (bInRoom)
 		SetMonsterSquare(pMonster);
 }
@@ -3543,6 +3628,12 @@ void CDbRoom::UnlinkMonster(
 //Params:
 	CMonster *pMonster)  //(in) Monster to remove
 {
+	//A monster that was already unlinked keeps its old neighbors, who no longer point to it.
+	const bool bInList = pMonster->pPrevious ? pMonster->pPrevious->pNext == pMonster :
+			pMonster == this->pFirstMonster;
+	if (bInList)
+		CountMonsterType(pMonster, false);
+
 	if (pMonster->pPrevious) pMonster->pPrevious->pNext = pMonster->pNext;
 	if (pMonster->pNext) pMonster->pNext->pPrevious = pMonster->pPrevious;
 	if (pMonster == this->pLastMonster) this->pLastMonster = pMonster->pPrevious;
@@ -3581,6 +3672,11 @@ const CMonster* CDbRoom::GetOwningMonsterOnSquare(const UINT wX, const UINT wY)
 CMonster* CDbRoom::GetMonsterOfType(const UINT wType) const
 //Returns: first monster of specified type in monster list, or NULL if none
 {
+	//Only characters can match a type other than their own.
+	if (!this->monsterTypeCounts[M_CHARACTER] &&
+			(!IsValidMonsterType(wType) || !this->monsterTypeCounts[wType]))
+		return NULL;
+
 	CMonster *pMonster = this->pFirstMonster;
 	while (pMonster)
 	{
@@ -5085,6 +5181,9 @@ void CDbRoom::ChangeTiles(const RoomTokenType tType)
 void CDbRoom::CharactersCheckForCueEvents(CCueEvents &CueEvents)
 //Called once all cue events on a given turn could have fired.
 {
+	if (!this->monsterTypeCounts[M_CHARACTER])
+		return;
+
 	CMonster *pMonster = this->pFirstMonster;
 	while (pMonster)
 	{
@@ -8238,6 +8337,10 @@ void CDbRoom::ClearMonsters(
 	this->pFirstMonster = pCharacters;  //usually NULL
 	this->wMonsterCount = this->wBrainCount = 0;
 
+	memset(this->monsterTypeCounts, 0, sizeof(this->monsterTypeCounts));
+	for (pSeek = this->pFirstMonster; pSeek != NULL; pSeek = pSeek->pNext)
+		CountMonsterType(pSeek, true);
+
 	//Don't delete Halph/Slayer entrance positions.
 }
 
@@ -9843,6 +9946,9 @@ void CDbRoom::SwitchTarstuff(const UINT wType1, const UINT wType2, CCueEvents& C
 								CueEvents.Add(eGrowth1,pNew);
 						}
 
+						CountMonsterType(pMonster, false);
+						CountMonsterType(pNew, true);
+
 						pMonster->pNext = pMonster->pPrevious = NULL;
 						KillMonster(pMonster, Ignored);
 
@@ -11604,6 +11710,8 @@ void CDbRoom::UpdateFields(c4_RowRef& row)
 	delete pSquaresBytes;
 	delete pLightsBytes;
 	delete[] pbytExtraBytes;
+
+	g_pTheDB->Rooms.ResetMapTiles(this->dwRoomID);
 }
 
 //*****************************************************************************
@@ -11850,6 +11958,26 @@ void CDbRoom::CopyTLayer(const list<RoomObject*>& src)
 	}
 }
 
+//*****************************************************************************
+void CDbRoom::CountMonsterType(
+//Keeps the per-type tally of the monster list in step as a monster is linked
+//or unlinked.
+//
+//Params:
+	const CMonster *pMonster, //(in)
+	const bool bAdd)          //(in) whether monster was added to the list
+{
+	ASSERT(IsValidMonsterType(pMonster->wType));
+	UINT& count = this->monsterTypeCounts[pMonster->wType];
+	if (bAdd)
+		++count;
+	else
+	{
+		ASSERT(count);
+		--count;
+	}
+}
+
 //*****************************************************************************
 void CDbRoom::SetExtraVarsFromMembers()
 //Pack extra vars.
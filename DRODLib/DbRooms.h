@@ -57,6 +57,7 @@
 #include <BackEndLib/CoordStack.h>
 
 #include <list>
+#include <map>
 
 //******************************************************************************************
 class CDbRooms;
@@ -496,6 +497,7 @@ private:
 	void           ClearStateVarsUsedDuringTurn();
 	void           CloseYellowDoor(const UINT wX, const UINT wY, CCueEvents &CueEvents);
 	void           CopyTLayer(const list<RoomObject*>& src);
+	void           CountMonsterType(const CMonster *pMonster, const bool bAdd);
 	void           DeletePathMaps();
 	CCoordStack    GetPowderKegsStillOnHotTiles() const;
 	void           ExplodeStabbedPowderKegs(CCueEvents& CueEvents);
@@ -565,6 +567,7 @@ private:
 
 	list<CMonster *>  DeadMonsters;
 	list<RoomObject*> DeadRoomObjects;
+	UINT           monsterTypeCounts[MONSTER_TYPES]; //number of monsters of each type in the monster list
 
 	vector<UINT> deletedScrollIDs;  //message text IDs to be deleted on Update
 	vector<UINT> deletedSpeechIDs;  //speech IDs to be deleted on Update
@@ -581,6 +584,19 @@ private:
 	bool room_lighting_changed;
 };
 
+//******************************************************************************************
+//What is needed to draw a room on the level map.
+struct RoomMapTiles
+{
+	RoomMapTiles() : dwRoomID(0), dwRoomX(0), dwRoomY(0), bIsRequired(false), bIsSecret(false) {}
+	bool HasTiles() const {return !this->oTiles.empty();}
+	void Set(const CDbRoom& room, const bool bWithTiles=true);
+
+	UINT dwRoomID, dwRoomX, dwRoomY;
+	bool bIsRequired, bIsSecret;
+	vector<BYTE> oTiles, tTiles; //o- and t-layer tile on each square, or empty if not loaded
+};
+
 //******************************************************************************************
 class CDbRooms : public CDbVDInterface<CDbRoom>
 {
@@ -606,6 +622,8 @@ public:
 	static UINT      GetHoldIDForRoom(const UINT dwRoomID);
 	static UINT      GetLevelIDForRoom(const UINT dwRoomID);
 	virtual CDbRoom * GetNew();
+	const RoomMapTiles* GetMapTiles(const UINT dwRoomID, const bool bWithTiles=true);
+	void     ResetMapTiles(const UINT dwRoomID=0);
 
 	void        LogRoomsWithItem(const UINT wTile, const UINT wParam=0);
 
@@ -613,6 +631,8 @@ private:
 	virtual void      LoadMembership();
 
 	UINT    dwFilterByLevelID;
+
+	std::map<UINT, RoomMapTiles> mapTiles; //cached until the room is next saved
 };
 
 bool bIsArrowObstacle(const UINT nArrowTile, const UINT nO);
@@ -792,6 +792,7 @@ bool CDbSavedGame::UpdateNew()
 	delete[] pbytStatsBytes;
 
 	CDb::addSavedGameToRoom(this->dwSavedGameID, this->dwRoomID);
+	CDb::indexSavedGameProgress(this->dwSavedGameID, this->dwPlayerID, this->dwRoomID, this->eType);
 
 	return true;
 }
@@ -843,6 +844,8 @@ bool CDbSavedGame::UpdateExisting()
 	delete[] pbytCommands;
 	delete[] pbytStatsBytes;
 
+	CDb::indexSavedGameProgress(this->dwSavedGameID, this->dwPlayerID, this->dwRoomID, this->eType);
+
 	return true;
 }
 
@@ -1097,6 +1100,7 @@ void CDbSavedGames::Delete(
 
 	CDb::deleteSavedGame(dwSavedGameID); //call first
 	SavedGamesView.RemoveAt(dwSavedGameRowI);
+	removePrimaryKeyRow(dwSavedGameID, V_SavedGames, dwSavedGameRowI);
 
 	//After object is deleted, membership might change, so reset the flag.
 	this->bIsMembershipLoaded = false;
@@ -1133,12 +1137,14 @@ void CDbSavedGames::VerifyForRoom(
 	//Test demos and their saved games...
 	CDb db;
 	CIDList DemoStats;
+	CIDSet demoSavedGameIDs;
 	CIDSet ids = CDb::getDemosInRoom(dwRoomID);
 	CIDSet::const_iterator iter;
 	for (iter = ids.begin(); iter != ids.end(); ++iter)
 	{
 		CDbDemo *pDemo = db.Demos.GetByID(*iter);
 		ASSERT(pDemo);
+		demoSavedGameIDs += pDemo->dwSavedGameID;	//don't recheck saved games for demos that were just checked
 		if (!pDemo->Test(DemoStats))
 			db.Demos.Delete(*iter);
 		else
@@ -1162,6 +1168,7 @@ void CDbSavedGames::VerifyForRoom(
 	CCueEvents Ignored;
 	CCurrentGame *pCurrentGame;
 	ids = CDb::getSavedGamesInRoom(dwRoomID);
+	ids -= demoSavedGameIDs; //skip ones already processed with demos
 	for (iter = ids.begin(); iter != ids.end(); ++iter)
 	{
 		pCurrentGame = db.GetSavedCurrentGame(*iter, Ignored, true);
@@ -1676,26 +1683,10 @@ UINT CDbSavedGames::FindByContinue(const UINT holdID) //[default=0 (current)]
 	const UINT dwCurrentPlayerID = g_pTheDB->GetPlayerID();
 	ASSERT(dwCurrentPlayerID);
 
-	const CIDSet savedGamesInHold = CDb::getSavedGamesInHold(holdID ? holdID : g_pTheDB->GetHoldID());
-
-	//Each iteration looks at one saved game record for a match.
-	c4_View SavedGamesView;
-	for (CIDSet::const_iterator savedGame = savedGamesInHold.begin();
-			savedGame != savedGamesInHold.end(); ++savedGame)
-	{
-		const UINT dwSavedGameI = LookupRowByPrimaryKey(*savedGame, V_SavedGames, SavedGamesView);
-		ASSERT(dwSavedGameI != ROW_NO_MATCH);
-		if (dwSavedGameI == ROW_NO_MATCH)
-			continue; //robustness guard
-		c4_RowRef row = SavedGamesView[dwSavedGameI];
-
-		if (SAVETYPE(int(p_Type(row))) == ST_Continue)
-			if (UINT(p_PlayerID(row)) == dwCurrentPlayerID)
-				return UINT(p_SavedGameID(row)); //Found it.
-	}
+	const UINT dwHoldID = holdID ? holdID : g_pTheDB->GetHoldID();
+	if (!dwHoldID) return 0;
 
-	//Didn't find one.
-	return 0;
+	return CDb::getContinueSavedGame(dwHoldID, dwCurrentPlayerID);
 }
 
 //*******************************************************************************
@@ -1781,27 +1772,7 @@ UINT CDbSavedGames::FindByEndHold(
 	const UINT dwCurrentPlayerID = playerID ? playerID : g_pTheDB->GetPlayerID();
 	ASSERT(dwCurrentPlayerID);
 
-	CIDSet savedGamesInHold = CDb::getSavedGamesInHold(dwQueryHoldID);
-
-	//Each iteration looks at one saved game record for a match.
-	c4_View SavedGamesView;
-	for (CIDSet::const_iterator savedGame = savedGamesInHold.begin();
-			savedGame != savedGamesInHold.end(); ++savedGame)
-	{
-		const UINT dwSavedGameI = LookupRowByPrimaryKey(*savedGame, V_SavedGames, SavedGamesView);
-		ASSERT(dwSavedGameI != ROW_NO_MATCH);
-		if (dwSavedGameI == ROW_NO_MATCH)
-			continue; //robustness guard
-		c4_RowRef row = SavedGamesView[dwSavedGameI];
-
-		if (SAVETYPE(int(p_Type(row))) != ST_EndHold)
-			continue;
-		if (UINT(p_PlayerID(row)) == dwCurrentPlayerID)
-			return UINT(*savedGame); //Found it.
-	}
-
-	//No end hold slot found for player in this hold.
-	return 0;
+	return CDb::getEndHoldSavedGame(dwQueryHoldID, dwCurrentPlayerID);
 }
 
 //*****************************************************************************
@@ -58,6 +58,7 @@ void CDbSpeeches::Delete(
 		g_pTheDB->Data.Delete(dwDataID);
 
 	SpeechView.RemoveAt(dwSpeechRowI);
+	removePrimaryKeyRow(dwSpeechID, V_Speech, dwSpeechRowI);
 
 	//After object is deleted, membership might change, so reset the flag.
 	this->bIsMembershipLoaded = false;
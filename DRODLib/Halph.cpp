@@ -108,7 +108,7 @@ void CHalph::Process(
 			//This will be calculated more quickly than a brain pathmap since player
 			//will almost always be within a couple squares of Halph.
 			CCoordSet dest(player.wX, player.wY);
-			this->pCurrentGame->pRoom->GetSwordCoords(this->swordsInRoom); //speed optimization
+			this->pCurrentGame->pRoom->GetSwordCoords(GetPathSearchContext().swordsInRoom); //speed optimization
 			const bool bRes = FindOptimalPathTo(this->wX, this->wY, dest);
 			player.wSwordX = wSaveSwordX;	//restore value
 			if (bRes)
@@ -197,7 +197,7 @@ bool CHalph::GetPathTo(
 	const CCoordSet *pDirectDests)  //(in) set of tiles that must be stepped on directly [default=NULL]
 {
 	//Confirm path to goal is still open.
-	this->pCurrentGame->pRoom->GetSwordCoords(this->swordsInRoom); //speed optimization
+	this->pCurrentGame->pRoom->GetSwordCoords(GetPathSearchContext().swordsInRoom); //speed optimization
 	if (!ConfirmPath())
 	{
 		//If it's not, search for a new path to the goal.
@@ -488,7 +488,7 @@ const
 		return true;
 
 	//Can't step on any swords.
-	if (this->swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
+	if (GetPathSearchContext().swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
 		return true;
 
 	//Player can never be stepped on.
@@ -564,7 +564,7 @@ void CHalph::RequestOpenDoor(
 	room.FindPlatesToOpenDoor(plates, doorSquares);
 
 	//Tell Halph to try to hit any of these orbs or step on these plates.
-	room.GetSwordCoords(this->swordsInRoom); //speed optimization
+	room.GetSwordCoords(GetPathSearchContext().swordsInRoom); //speed optimization
 	bool bPlatePathFound = false;
 	bool bOrbPathFound = FindOptimalPathTo(this->wX, this->wY, orbs);
 	if (bOrbPathFound)
@@ -34,6 +34,7 @@
 #include "Character.h"
 #include "CurrentGame.h"
 #include "DbRooms.h"
+#include "PathSearch.h"
 #include <BackEndLib/Base64.h>
 #include <BackEndLib/Ports.h>
 
@@ -41,49 +42,12 @@
 
 #define NO_TARGET ((UINT)-1) //this distance to a target represents no valid option
 
-CCoordIndex_T<UINT> CMonster::room;
-CCoordIndex CMonster::searchMoves;
-CCoordIndex CMonster::swordsInRoom;
-bool CMonster::calculatingPathmap = false;
-
-//Node object used in pathfinding search.
-class CPathNode : public CCoord
-{
-public:
-	CPathNode(const UINT wX, const UINT wY, const UINT wCost, const UINT wScore)
-		: CCoord(wX, wY)
-		, wCost(wCost), wScore(wScore)
-	{ }
-	UINT wCost;    //f -- distance already traveled
-	UINT wScore;   //f+g -- cost + lowest possible remaining distance to goal
-
-	//For priority queue insertion:
-	//An element being inserted with equal or higher dwScore gets placed later in the queue.
-	//FIXME: The current operator could have different behavior, based on implementation.
-	bool operator <(const CPathNode& mc) const {return this->wScore >= mc.wScore;}
-};
-
-//Fixed version
-class CPathNode2 : public CCoord
-{
-public:
-	CPathNode2(const UINT wX, const UINT wY, const UINT wCost, const UINT wScore)
-		: CCoord(wX, wY)
-		, wCost(wCost), wScore(wScore)
-	{ }
-	UINT wCost;    //f -- distance already traveled
-	UINT wScore;   //f+g -- cost + lowest possible remaining distance to goal
-
-	//For priority queue insertion:
-	bool operator <(const CPathNode2& mc) const {return mc.wScore < this->wScore;}
-};
-
 namespace Path
 {
 	const UINT wNumNeighbors = 8;
 	const int dXs[wNumNeighbors] = { 0,  1,  0, -1,  1,  1, -1, -1};
 	const int dYs[wNumNeighbors] = {-1,  0,  1,  0, -1,  1,  1, -1};
-	const UINT O_MOD = 16;   //each cell in CMonster::room stores (dist * O_MOD + direction from previous square)
+	const UINT O_MOD = 16;   //each cell in CPathSearch::room stores (dist * O_MOD + direction from previous square)
 }
 
 //
@@ -581,7 +545,7 @@ CheckMonster:
 			)
 		){
 
-			if (!CMonster::calculatingPathmap || pMonster->IsNPCPathmapObstacle())
+			if (!GetPathSearchContext().bCalculatingPathmap || pMonster->IsNPCPathmapObstacle())
 				return true;
 		}
 	}
@@ -737,21 +701,26 @@ bool CMonster::FindOptimalPathTo(
 	if (dests.empty())
 		return false; //no destination specified
 
+	CDbRoom& curGameRoom = *(this->pCurrentGame->pRoom);
+	CPathSearchLease search(GetPathSearchContext());
+	search->SetDestinations(dests, curGameRoom.wRoomCols, curGameRoom.wRoomRows);
+
 	//Find closest destination.
 	const int nCloseEnough = bAdjIsGood ? 1 : 0;
-	int dist = getMinDistance(wX, wY, dests, this->goal);
+	int dist = search->GetMinDistance(wX, wY, this->goal);
 	if (dist <= nCloseEnough)
 		return true;   //Next to the destination -- no search needed.
 
 	//Init search.
-	CDbRoom& curGameRoom = *(this->pCurrentGame->pRoom);
-	VERIFY(CMonster::room.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
+	CCoordIndex_T<UINT>& room = search->room;
+	VERIFY(room.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
 
 	//Push starting node.
-	const UINT dwCostThroughObstacle = CMonster::room.GetArea() * Path::O_MOD;
-	CMonster::room.Add(wX, wY, Path::O_MOD + Path::wNumNeighbors);  //small number ensures this square will never be visited
+	const UINT dwCostThroughObstacle = room.GetArea() * Path::O_MOD;
+	room.Add(wX, wY, Path::O_MOD + Path::wNumNeighbors);  //small number ensures this square will never be visited
 	CPathNode coord(wX, wY, 0, dist);
-	priority_queue<CPathNode> open;
+	CPathOpenList<CPathNode>& open = search->open;
+	open.clear();
 	open.push(coord);
 
 	UINT bestScore = 0;
@@ -773,7 +742,7 @@ bool CMonster::FindOptimalPathTo(
 			wNewX = coord.wX + (dx = Path::dXs[nIndex]);
 			wNewY = coord.wY + (dy = Path::dYs[nIndex]);
 			if (!curGameRoom.IsValidColRow(wNewX, wNewY)) continue;
-			const UINT wSquareScore = CMonster::room.GetAt(wNewX,wNewY) / Path::O_MOD;
+			const UINT wSquareScore = room.GetAt(wNewX,wNewY) / Path::O_MOD;
 			//Only allow visiting a square if (1) it hasn't been visited, or
 			//(2) this is the shortest path to the square so far.
 			if (wSquareScore && wSquareScore <= wCostPlusOne) continue;
@@ -788,14 +757,14 @@ bool CMonster::FindOptimalPathTo(
 						continue;
 				}
 
-				CMonster::room.Add(wNewX, wNewY, newScore); //node is now visited
+				room.Add(wNewX, wNewY, newScore); //node is now visited
 
-				dist = getMinDistance(wNewX, wNewY, dests, this->goal);
+				dist = search->GetMinDistance(wNewX, wNewY, this->goal);
 				if (dist <= nCloseEnough) //Close enough to destination.
 				{
 					//Construct path to goal.
 					this->pathToDest.Clear();
-					PushPathFromGoal(UINT(wNewX), UINT(wNewY), wX, wY);
+					PushPathFromGoal(room, UINT(wNewX), UINT(wNewY), wX, wY);
 					if (bOpenMove)
 						return true; //guaranteed best path
 					//otherwise, allow search to continue until no better path might be found
@@ -832,21 +801,26 @@ bool CMonster::FindOptimalPath2(
 	this->goal.wX = wGoalX;
 	this->goal.wY = wGoalY;
 	CDbRoom& curGameRoom = *(this->pCurrentGame->pRoom);
-	VERIFY(CMonster::room.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
-	VERIFY(CMonster::searchMoves.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
+	CPathSearchContext& context = GetPathSearchContext();
+	CPathSearchLease search(context);
+	CCoordIndex_T<UINT>& room = search->room;
+	CCoordIndex& searchMoves = search->searchMoves;
+	VERIFY(room.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
+	VERIFY(searchMoves.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
 
 	//larger than the sum of move indexes for a path of maximum possible length
-	const UINT STEP_INC = CMonster::room.GetArea() * Path::O_MOD;
+	const UINT STEP_INC = room.GetArea() * Path::O_MOD;
 
-	const UINT dwCostThroughObstacle = STEP_INC * CMonster::room.GetArea();
+	const UINT dwCostThroughObstacle = STEP_INC * room.GetArea();
 	ASSERT(dwCostThroughObstacle < UINT(-1) / max(curGameRoom.wRoomCols, curGameRoom.wRoomRows)); //avoid potential overflow
 
 	//Push starting node.
-	CMonster::room.Add(wStartX, wStartY, 1);  //small number ensures this square will never be visited
-	CMonster::searchMoves.Add(wStartX, wStartY, 1+this->wO);
+	room.Add(wStartX, wStartY, 1);  //small number ensures this square will never be visited
+	searchMoves.Add(wStartX, wStartY, 1+this->wO);
 	int dist = nDist(wStartX, wStartY, wGoalX, wGoalY);
 	CPathNode2 coord(wStartX, wStartY, 0, dist*STEP_INC);
-	priority_queue<CPathNode2> open;
+	CPathOpenList<CPathNode2>& open = search->open2;
+	open.clear();
 	open.push(coord);
 
 	UINT bestScore = 0;
@@ -868,10 +842,10 @@ bool CMonster::FindOptimalPath2(
 			wNewX = coord.wX + (dx = Path::dXs[nIndex]);
 			wNewY = coord.wY + (dy = Path::dYs[nIndex]);
 			if (!curGameRoom.IsValidColRow(wNewX, wNewY)) continue;
-			const UINT wSquareScore = CMonster::room.GetAt(wNewX, wNewY);
+			const UINT wSquareScore = room.GetAt(wNewX, wNewY);
 			UINT newScore = wNextStepCost +
 					nIndex*2; //break ties on movement direction
-			const bool bChangedDirection = (1+nIndex != CMonster::searchMoves.GetAt(coord.wX, coord.wY));
+			const bool bChangedDirection = (1+nIndex != searchMoves.GetAt(coord.wX, coord.wY));
 			if (bChangedDirection)
 				++newScore; //...and whether turning was required to make this step
 
@@ -882,9 +856,9 @@ bool CMonster::FindOptimalPath2(
 			//If monster can move to this square...
 
 			//pathmapping through NPCs flagged to pathmap through is only considered on later moves in the path
-			CMonster::calculatingPathmap = coord.wX != wStartX || coord.wY != wStartY;
+			context.bCalculatingPathmap = coord.wX != wStartX || coord.wY != wStartY;
 			const bool bOpenMove = IsOpenMove(coord.wX, coord.wY, dx, dy) || (UINT(wNewX) == wGoalX && UINT(wNewY) == wGoalY);
-			CMonster::calculatingPathmap = false;
+			context.bCalculatingPathmap = false;
 
 			if (bOpenMove || bPathThroughObstacles)
 			{
@@ -894,8 +868,8 @@ bool CMonster::FindOptimalPath2(
 						continue;
 				}
 
-				CMonster::room.Add(wNewX, wNewY, newScore); //node is now visited
-				CMonster::searchMoves.Add(wNewX, wNewY, 1+nIndex); //direction moved to get here
+				room.Add(wNewX, wNewY, newScore); //node is now visited
+				searchMoves.Add(wNewX, wNewY, 1+nIndex); //direction moved to get here
 
 				dist = nDist(wNewX, wNewY, wGoalX, wGoalY);
 				if (!dist)
@@ -906,7 +880,7 @@ bool CMonster::FindOptimalPath2(
 					{
 						this->pathToDest.Push(wNewX, wNewY);
 						//Reverse the step made to this square.
-						const UINT wO = CMonster::searchMoves.GetAt(wNewX, wNewY) - 1;
+						const UINT wO = searchMoves.GetAt(wNewX, wNewY) - 1;
 						ASSERT(wO < Path::wNumNeighbors);
 						wNewX -= Path::dXs[wO];
 						wNewY -= Path::dYs[wO];
@@ -939,12 +913,15 @@ bool CMonster::FindOptimalPathToClosestMonster(
 	//Init search.
 	this->pathToDest.Clear();
 	CDbRoom& curGameRoom = *(this->pCurrentGame->pRoom);
-	VERIFY(CMonster::room.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
+	CPathSearchLease search(GetPathSearchContext());
+	CCoordIndex_T<UINT>& room = search->room;
+	VERIFY(room.Init(curGameRoom.wRoomCols, curGameRoom.wRoomRows));
 
 	//Push starting node.
-	CMonster::room.Add(wX,wY, Path::O_MOD + Path::wNumNeighbors);  //large number ensures this square will never be visited
+	room.Add(wX,wY, Path::O_MOD + Path::wNumNeighbors);  //large number ensures this square will never be visited
 	CPathNode coord(wX, wY, 0, 1);
-	priority_queue<CPathNode> open;
+	CPathOpenList<CPathNode>& open = search->open;
+	open.clear();
 	open.push(coord);
 
 	UINT wGoalDistance = 0;
@@ -967,7 +944,7 @@ bool CMonster::FindOptimalPathToClosestMonster(
 			wNewY = coord.wY + (dy = Path::dYs[nIndex]);
 			if (!curGameRoom.IsValidColRow(wNewX, wNewY))
 				continue;
-			const UINT wSquareScore = CMonster::room.GetAt(wNewX,wNewY) / Path::O_MOD;
+			const UINT wSquareScore = room.GetAt(wNewX,wNewY) / Path::O_MOD;
 			//Only allow visiting a square if (1) it hasn't been visited, or
 			//(2) this is the shortest path to the square so far.
 			if (wSquareScore && wSquareScore <= wCostPlusOne)
@@ -983,7 +960,7 @@ bool CMonster::FindOptimalPathToClosestMonster(
 					wGoalDistance = wCostPlusOne;
 					this->goal.wX = wNewX;
 					this->goal.wY = wNewY;
-					CMonster::room.Add(wNewX, wNewY, wGoalDistance * Path::O_MOD + nIndex);  //last node in path
+					room.Add(wNewX, wNewY, wGoalDistance * Path::O_MOD + nIndex);  //last node in path
 
 					//Continue searching for better path to this goal until done.
 					break;
@@ -996,7 +973,7 @@ bool CMonster::FindOptimalPathToClosestMonster(
 				//...Add this unvisited node to priority queue.
 				const UINT newScore = wCostPlusOne * Path::O_MOD + nIndex;
 				open.push(CPathNode(wNewX, wNewY, newScore, newScore));
-				CMonster::room.Add(wNewX, wNewY, newScore);  //node is now visited
+				room.Add(wNewX, wNewY, newScore);  //node is now visited
 			}
 		}
 	} while (!open.empty());
@@ -1005,18 +982,20 @@ bool CMonster::FindOptimalPathToClosestMonster(
 		return false; //No path found.
 
 	//Construct path to goal.
-	PushPathFromGoal(this->goal.wX, this->goal.wY, wX, wY);
+	PushPathFromGoal(room, this->goal.wX, this->goal.wY, wX, wY);
 	ASSERT(this->pathToDest.GetSize() == wGoalDistance);
 	return true;
 }
 
-void CMonster::PushPathFromGoal(UINT endX, UINT endY, UINT startX, UINT startY)
+void CMonster::PushPathFromGoal(
+	const CCoordIndex_T<UINT>& room, //(in) search grid holding the step into each square
+	UINT endX, UINT endY, UINT startX, UINT startY)
 {
 	while (endX != startX || endY != startY)  //until starting point is returned to
 	{
 		this->pathToDest.Push(endX, endY);
 		//Reverse the step made to this square.
-		const UINT wO = CMonster::room.GetAt(endX, endY) % Path::O_MOD;
+		const UINT wO = room.GetAt(endX, endY) % Path::O_MOD;
 		ASSERT(wO < Path::wNumNeighbors);
 		endX -= Path::dXs[wO];
 		endY -= Path::dYs[wO];
@@ -1048,6 +1027,14 @@ const
 	return nMin;
 }
 
+//*****************************************************************************
+CPathSearchContext& CMonster::GetPathSearchContext() const
+//Returns: the pathfinding state of the game this monster is in
+{
+	ASSERT(this->pCurrentGame);
+	return const_cast<CCurrentGame*>(this->pCurrentGame)->pathSearchContext;
+}
+
 //*****************************************************************************
 void CMonster::GetCommandDXY(int nCommand, int &dx, int &dy)
 {
@@ -205,6 +205,7 @@ class CCueEvents;
 class CCurrentGame;
 class CMonsterFactory;
 class CDbRoom;
+class CPathSearchContext;
 class CMonster : public CEntity
 {
 protected:
@@ -358,6 +359,7 @@ public:
 protected:
 	virtual bool  CanMoveOntoTunnelAt(UINT col, UINT row) const;
 
+	CPathSearchContext& GetPathSearchContext() const;
 	int           getMinDistance(const UINT wX, const UINT wY, const CCoordSet &dests,
 			ROOMCOORD& closestDest) const;
 
@@ -369,13 +371,9 @@ protected:
 	CCoordStack pathToDest; //sequence of squares that lead to preferred goal coord
 	ROOMCOORD goal; //goal coord
 
-	static CCoordIndex_T<UINT> room; //for breadth-first search
-	static CCoordIndex searchMoves;  //moves made during search
-	static CCoordIndex swordsInRoom;  //speed optimization for pathmapping
-	static bool calculatingPathmap;
-
 private:
-	void          PushPathFromGoal(UINT endX, UINT endY, UINT startX, UINT startY);
+	void          PushPathFromGoal(const CCoordIndex_T<UINT>& room,
+			UINT endX, UINT endY, UINT startX, UINT startY);
 };
 
 #endif //...#ifndef MONSTER_H
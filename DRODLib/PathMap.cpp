@@ -44,6 +44,9 @@
 
 const UINT dwBigVal = UINT(-1); //this value indicates a tile is not part of the valid pathmap
 
+//Number of targets whose calculated paths are kept for reuse.
+const UINT MAX_CACHED_PATHS = 4;
+
 //**********************************************************************************
 CPathMap::CPathMap(
 //Constructor.  Sets object vars to default values and allocates and initializes the map squares and immediate
@@ -60,6 +63,8 @@ CPathMap::CPathMap(
 	, xTarget(xTarget), yTarget(yTarget)
 	, dwPathThroughObstacleCost(dwPathThroughObstacleCost)
 	, bSupportPartialObstacles(bSupportPartialObstacles)
+	, bResetPending(false)
+	, dwCacheStamp(0)
 {
 	//Allocate map.  Initialize map squares.
 	const UINT wArea=wCols*wRows;
@@ -79,6 +84,9 @@ void CPathMap::CalcPaths()
 //unchanged and there is still a previous call did not calculate paths for all
 //squares, this work is continued.
 {
+	if (this->bResetPending)
+		Reset();
+
 	if (this->recalcSquares.empty())
 		return;
 
@@ -165,6 +173,23 @@ void CPathMap::CalcPaths()
 #endif // DEBUG_PATHMAP
 }
 
+//**********************************************************************************
+UINT CPathMap::FindCachedPaths(const UINT xTarget, const UINT yTarget) const
+//Returns: index of the paths held for the given target, or (UINT)-1 if none are
+{
+	//Spare slots are marked with an invalid target, so never match one.
+	if (xTarget >= this->wCols || yTarget >= this->wRows)
+		return (UINT)-1;
+
+	for (UINT wI=0; wI<this->cachedPaths.size(); ++wI)
+	{
+		const CachedPaths& cache = this->cachedPaths[wI];
+		if (cache.xTarget == xTarget && cache.yTarget == yTarget)
+			return wI;
+	}
+	return (UINT)-1;
+}
+
 //**********************************************************************************
 void CPathMap::GetEntrances(
 //Get a list of entrances, sorted by distance to target
@@ -248,6 +273,8 @@ void CPathMap::Reset()
 //Changes:
 //this->squares
 {
+	this->bResetPending = false;
+
 	const UINT wLastSquareI=this->wRows*this->wCols;
 	
 	//Initialize all of the map squares.
@@ -273,6 +300,28 @@ void CPathMap::Reset()
 	this->recalcSquares.push(SORTPOINT(this->xTarget, this->yTarget));
 }
 
+//***************************************************************************
+void CPathMap::RestoreCachedPaths(const UINT wCacheI)
+//Restores paths previously calculated to the current target.
+//The result is identical to recalculating them.
+//
+//The cached buffer is swapped in, and the replaced one is left in its slot as a
+//spare, so no square data is copied.
+{
+	ASSERT(wCacheI < this->cachedPaths.size());
+	CachedPaths& cache = this->cachedPaths[wCacheI];
+	ASSERT(cache.xTarget == this->xTarget && cache.yTarget == this->yTarget);
+	ASSERT(cache.squares.size() == this->squares.size());
+
+	this->squares.swap(cache.squares);
+	this->entrySquares = cache.entrySquares;
+	while (!this->recalcSquares.empty())
+		this->recalcSquares.pop();
+	this->bResetPending = false;
+
+	cache.xTarget = cache.yTarget = (UINT)-1;
+}
+
 //*****************************************************************************
 void CPathMap::SetMembers(const CPathMap& Src)
 //Perform deep copy.
@@ -285,6 +334,10 @@ void CPathMap::SetMembers(const CPathMap& Src)
 	this->yTarget = Src.yTarget;
 	this->recalcSquares = Src.recalcSquares;
 	this->entrySquares = Src.entrySquares;
+	this->bResetPending = Src.bResetPending;
+	//Cached paths aren't copied, to keep room copies small.
+	this->cachedPaths.clear();
+	this->dwCacheStamp = 0;
 
 	this->bSupportPartialObstacles = Src.bSupportPartialObstacles;
 
@@ -309,7 +362,20 @@ void CPathMap::SetSquare(
 	//	eBlockedDirections = DMASK_ALL;
 
 	if (square.eBlockedDirections != eBlockedDirections)
-		Reset();
+	{
+		//Paths will be recalculated when next queried.
+		this->bResetPending = true;
+
+		//Cached paths are now invalid, but their buffers are kept as spares,
+		//so their obstacles must stay in step with this map's.
+		const UINT wSquareI = GetSquareIndex(wX,wY);
+		for (std::vector<CachedPaths>::iterator cache = this->cachedPaths.begin();
+				cache != this->cachedPaths.end(); ++cache)
+		{
+			cache->xTarget = cache->yTarget = (UINT)-1;
+			cache->squares[wSquareI].eBlockedDirections = eBlockedDirections;
+		}
+	}
 
 	square.eBlockedDirections = eBlockedDirections;
 }
@@ -326,10 +392,63 @@ void CPathMap::SetTarget(
 {
 	if (xTarget!=this->xTarget || yTarget!=this->yTarget)
 	{
+		const UINT wCacheI = FindCachedPaths(xTarget, yTarget);
+		StashPaths(wCacheI);
+
 		this->xTarget=xTarget;
 		this->yTarget=yTarget;
-		Reset();
+		if (wCacheI != (UINT)-1)
+			RestoreCachedPaths(wCacheI);
+		else
+			this->bResetPending = true; //recalculate when next queried
+	}
+}
+
+//**********************************************************************************
+void CPathMap::StashPaths(
+//Keeps the completed paths to the current target, so they can be restored if
+//the target returns here before any obstacles change.
+//
+//The map's buffer is swapped into a cache slot, taking that slot's buffer in
+//exchange.  Only while the cache is first filling is a buffer copied.
+//
+//Accepts:
+	const UINT wKeepI) //cache slot that must not be reused, or (UINT)-1
+{
+	if (this->bResetPending || !this->recalcSquares.empty() ||
+			this->xTarget >= this->wCols || this->yTarget >= this->wRows)
+		return; //no complete paths to keep
+
+	//Prefer a spare slot, then a new one, then the least recently stashed one.
+	UINT wSlotI = (UINT)-1, wI;
+	for (wI=0; wI<this->cachedPaths.size(); ++wI)
+	{
+		if (wI == wKeepI)
+			continue;
+		const CachedPaths& cache = this->cachedPaths[wI];
+		if (cache.xTarget == (UINT)-1)
+		{
+			wSlotI = wI;
+			break;
+		}
+		if (wSlotI == (UINT)-1 || cache.dwStamp < this->cachedPaths[wSlotI].dwStamp)
+			wSlotI = wI;
+	}
+	if (wI == this->cachedPaths.size() && this->cachedPaths.size() < MAX_CACHED_PATHS)
+	{
+		wSlotI = this->cachedPaths.size();
+		this->cachedPaths.push_back(CachedPaths());
 	}
+	ASSERT(wSlotI < this->cachedPaths.size());
+
+	CachedPaths& cache = this->cachedPaths[wSlotI];
+	cache.squares.swap(this->squares);
+	if (this->squares.empty())
+		this->squares = cache.squares; //new buffer: only its obstacles matter
+	cache.entrySquares = this->entrySquares;
+	cache.xTarget = this->xTarget;
+	cache.yTarget = this->yTarget;
+	cache.dwStamp = ++this->dwCacheStamp;
 }
 
 //*****************************************************************************
@@ -0,0 +1,205 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 1995, 1996,
+ * 1997, 2000, 2001, 2002, 2005 Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+#include "PathSearch.h"
+#include "GameConstants.h"
+
+//Building the distance field costs about this many dest comparisons per room square.
+const UINT FIELD_BUILD_COST = 8;
+
+const UINT NO_DISTANCE = UINT(-1);
+
+//*****************************************************************************
+CPathSearch::CPathSearch()
+	: wCols(0), wRows(0)
+	, dwDirectWork(0)
+	, bDestsInRoom(false)
+{
+}
+
+//*****************************************************************************
+void CPathSearch::SetDestinations(
+//Sets the goal squares that GetMinDistance measures against.
+//
+//Params:
+	const CCoordSet& dests,           //(in) possible goal destinations
+	const UINT wCols, const UINT wRows) //(in) room dimensions
+{
+	this->dests.clear();
+	this->distanceField.clear();
+	this->wCols = wCols;
+	this->wRows = wRows;
+	this->dwDirectWork = 0;
+
+	//The field can only describe dests within the room.
+	this->bDestsInRoom = wCols * wRows <= 0xFFFF;
+	for (CCoordSet::const_iterator dest=dests.begin(); dest!=dests.end(); ++dest)
+	{
+		this->dests.push_back(*dest);
+		if (dest->wX >= wCols || dest->wY >= wRows)
+			this->bDestsInRoom = false;
+	}
+}
+
+//*****************************************************************************
+int CPathSearch::GetMinDistance(
+//Returns: minimum distance from (wX,wY) to any of the destinations.
+//Gives the same result as CMonster::getMinDistance, including which of several
+//equally close destinations is reported.
+//
+//Params:
+	const UINT wX, const UINT wY, //(in) square
+	ROOMCOORD& closestDest)       //(out) closest goal destination
+{
+	ASSERT(!this->dests.empty());
+
+	//A search that keeps scanning a long dest list is better served by
+	//computing every square's closest dest at once.
+	if (this->distanceField.empty() && this->bDestsInRoom)
+	{
+		this->dwDirectWork += this->dests.size();
+		if (this->dwDirectWork > this->wCols * this->wRows * FIELD_BUILD_COST)
+			BuildDistanceField();
+	}
+
+	if (!this->distanceField.empty() && wX < this->wCols && wY < this->wRows)
+	{
+		const UINT dwArea = this->wCols * this->wRows;
+		const UINT val = this->distanceField[wY * this->wCols + wX];
+		closestDest = this->dests[val % dwArea];
+		return int(val / dwArea);
+	}
+
+	int nSize, nMin = 9999;
+	for (vector<ROOMCOORD>::const_iterator dest=this->dests.begin();
+			dest!=this->dests.end(); ++dest)
+	{
+		nSize = nDist(wX, wY, dest->wX, dest->wY);
+		if (nSize < nMin)
+		{
+			//Closest destination found.
+			nMin = nSize;
+			closestDest = *dest;
+		}
+	}
+	return nMin;
+}
+
+//*****************************************************************************
+void CPathSearch::BuildDistanceField()
+//Breadth-first search outward from all dests at once.
+//Each square records (distance * area + index of its closest dest).  When dests
+//tie, the one earliest in CCoordSet order wins, as in a linear scan.
+{
+	ASSERT(this->bDestsInRoom);
+	const UINT dwArea = this->wCols * this->wRows;
+	this->distanceField.assign(dwArea, NO_DISTANCE);
+	this->fieldQueue.clear();
+
+	UINT wIndex;
+	for (wIndex=0; wIndex<this->dests.size(); ++wIndex)
+	{
+		const UINT square = this->dests[wIndex].wY * this->wCols + this->dests[wIndex].wX;
+		this->distanceField[square] = wIndex;
+		this->fieldQueue.push_back(square);
+	}
+
+	//Squares are dequeued in order of distance, so each square's value is final
+	//before any square one step farther out is expanded.
+	for (UINT next=0; next<this->fieldQueue.size(); ++next)
+	{
+		const UINT square = this->fieldQueue[next];
+		const UINT nextVal = this->distanceField[square] + dwArea; //one step farther
+		const int wX = int(square % this->wCols);
+		const int wY = int(square / this->wCols);
+		for (int dy=-1; dy<=1; ++dy)
+		{
+			const int wNewY = wY + dy;
+			if (wNewY < 0 || wNewY >= int(this->wRows))
+				continue;
+			for (int dx=-1; dx<=1; ++dx)
+			{
+				const int wNewX = wX + dx;
+				if (wNewX < 0 || wNewX >= int(this->wCols))
+					continue;
+				UINT& val = this->distanceField[wNewY * this->wCols + wNewX];
+				if (nextVal < val)
+				{
+					if (val == NO_DISTANCE)
+						this->fieldQueue.push_back(wNewY * this->wCols + wNewX);
+					val = nextVal;
+				}
+			}
+		}
+	}
+}
+
+//
+//CPathSearchContext
+//
+
+//*****************************************************************************
+CPathSearchContext::CPathSearchContext()
+	: bCalculatingPathmap(false)
+	, wInUse(0)
+{
+}
+
+//*****************************************************************************
+CPathSearchContext::CPathSearchContext(const CPathSearchContext& that)
+//Search buffers are scratch space and aren't copied.
+	: swordsInRoom(that.swordsInRoom)
+	, bCalculatingPathmap(that.bCalculatingPathmap)
+	, wInUse(0)
+{
+}
+
+//*****************************************************************************
+CPathSearchContext::~CPathSearchContext()
+{
+	ASSERT(!this->wInUse);
+	for (vector<CPathSearch*>::const_iterator search = this->searches.begin();
+			search != this->searches.end(); ++search)
+		delete *search;
+}
+
+//*****************************************************************************
+CPathSearch* CPathSearchContext::Acquire()
+//Returns: a search not currently in use, allocating one only when all are busy
+{
+	if (this->wInUse == this->searches.size())
+		this->searches.push_back(new CPathSearch);
+	return this->searches[this->wInUse++];
+}
+
+//*****************************************************************************
+void CPathSearchContext::Release(CPathSearch *pSearch)
+//Searches are released in the reverse order they were acquired.
+{
+	ASSERT(this->wInUse);
+	ASSERT(this->searches[this->wInUse-1] == pSearch);
+	--this->wInUse;
+}
@@ -0,0 +1,173 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 1995, 1996,
+ * 1997, 2000, 2001, 2002, 2005 Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+//Working state for monster pathfinding.
+//
+//A CPathSearch holds the grids, open lists and destination data used by one
+//search in CMonster.  Searches are leased from the CPathSearchContext owned by
+//the game being played, so their buffers are reused from one search to the next
+//instead of being reallocated, and a search started while another is in
+//progress gets its own state.
+//
+//The open lists order nodes exactly as std::priority_queue does, since the
+//order in which equally scored nodes are expanded decides which of several
+//equally short paths a monster takes, and recorded demos depend on that choice.
+
+#ifndef PATHSEARCH_H
+#define PATHSEARCH_H
+
+#include <BackEndLib/Coord.h>
+#include <BackEndLib/CoordIndex.h>
+#include <BackEndLib/CoordSet.h>
+
+#include <algorithm>
+#include <vector>
+using std::vector;
+
+//Node object used in pathfinding search.
+class CPathNode : public CCoord
+{
+public:
+	CPathNode(const UINT wX, const UINT wY, const UINT wCost, const UINT wScore)
+		: CCoord(wX, wY)
+		, wCost(wCost), wScore(wScore)
+	{ }
+	UINT wCost;    //f -- distance already traveled
+	UINT wScore;   //f+g -- cost + lowest possible remaining distance to goal
+
+	//For priority queue insertion:
+	//An element being inserted with equal or higher dwScore gets placed later in the queue.
+	//FIXME: The current operator could have different behavior, based on implementation.
+	bool operator <(const CPathNode& mc) const {return this->wScore >= mc.wScore;}
+};
+
+//Fixed version
+class CPathNode2 : public CCoord
+{
+public:
+	CPathNode2(const UINT wX, const UINT wY, const UINT wCost, const UINT wScore)
+		: CCoord(wX, wY)
+		, wCost(wCost), wScore(wScore)
+	{ }
+	UINT wCost;    //f -- distance already traveled
+	UINT wScore;   //f+g -- cost + lowest possible remaining distance to goal
+
+	//For priority queue insertion:
+	bool operator <(const CPathNode2& mc) const {return mc.wScore < this->wScore;}
+};
+
+//*****************************************************************************
+//Priority queue over a vector that keeps its storage between searches.
+//Push and pop are the same heap operations std::priority_queue performs,
+//so nodes come off in the same order.
+template <typename NODE>
+class CPathOpenList
+{
+public:
+	void clear() {this->nodes.clear();}
+	bool empty() const {return this->nodes.empty();}
+	const NODE& top() const {return this->nodes.front();}
+
+	void push(const NODE& node) {
+		this->nodes.push_back(node);
+		std::push_heap(this->nodes.begin(), this->nodes.end());
+	}
+	void pop() {
+		std::pop_heap(this->nodes.begin(), this->nodes.end());
+		this->nodes.pop_back();
+	}
+
+private:
+	vector<NODE> nodes;
+};
+
+//*****************************************************************************
+class CPathSearch
+{
+public:
+	CPathSearch();
+
+	int   GetMinDistance(const UINT wX, const UINT wY, ROOMCOORD& closestDest);
+	void  SetDestinations(const CCoordSet& dests, const UINT wCols, const UINT wRows);
+
+	CCoordIndex_T<UINT> room; //for breadth-first search
+	CCoordIndex searchMoves;  //moves made during search
+	CPathOpenList<CPathNode> open;
+	CPathOpenList<CPathNode2> open2;
+
+private:
+	void  BuildDistanceField();
+
+	vector<ROOMCOORD> dests; //in CCoordSet order
+	vector<UINT> distanceField; //per square: dist * area + index of closest dest
+	vector<UINT> fieldQueue;
+	UINT wCols, wRows;
+	UINT dwDirectWork;    //dest comparisons made without the distance field
+	bool bDestsInRoom;
+};
+
+//*****************************************************************************
+class CPathSearchContext
+{
+public:
+	CPathSearchContext();
+	CPathSearchContext(const CPathSearchContext& that);
+	~CPathSearchContext();
+
+	CPathSearch* Acquire();
+	void  Release(CPathSearch *pSearch);
+
+	CCoordIndex swordsInRoom; //speed optimization for pathmapping
+	bool bCalculatingPathmap; //NPCs flagged to be pathmapped through aren't obstacles
+
+private:
+	CPathSearchContext& operator=(const CPathSearchContext&);
+
+	vector<CPathSearch*> searches; //the first wInUse are leased
+	UINT wInUse;
+};
+
+//*****************************************************************************
+//Leases a search from a context for the duration of a scope.
+class CPathSearchLease
+{
+public:
+	CPathSearchLease(CPathSearchContext& context)
+		: context(context), pSearch(context.Acquire()) {}
+	~CPathSearchLease() {this->context.Release(this->pSearch);}
+
+	CPathSearch& operator*() const {return *this->pSearch;}
+	CPathSearch* operator->() const {return this->pSearch;}
+
+private:
+	CPathSearchLease(const CPathSearchLease&);
+	CPathSearchLease& operator=(const CPathSearchLease&);
+
+	CPathSearchContext& context;
+	CPathSearch *pSearch;
+};
+
+#endif //...#ifndef PATHSEARCH_H
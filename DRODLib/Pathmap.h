@@ -120,8 +120,11 @@ public:
 	std::vector<SQUARE> squares;
 
 private:
+	UINT              FindCachedPaths(const UINT xTarget, const UINT yTarget) const;
 	inline UINT       GetSquareIndex(const UINT x, const UINT y) const;
+	void              RestoreCachedPaths(const UINT wCacheI);
 	static void       StableSortPoints(SORTPOINTS& sortPoints);
+	void              StashPaths(const UINT wKeepI);
 
 	UINT xTarget, yTarget;
 	std::priority_queue<SORTPOINT> recalcSquares;
@@ -129,6 +132,23 @@ private:
 	//closest entrance squares to target
 	std::priority_queue<SORTPOINT> entrySquares;
 
+	//Set when squares need to be reset before paths are next calculated.
+	//Several obstacle changes in a turn then cost only one reset.
+	bool bResetPending;
+
+	//Paths calculated to recently used targets.  Only valid while no square's
+	//obstacles change, so these are invalidated on any such change.  Slots with
+	//no target hold spare buffers, whose obstacles are kept current.
+	struct CachedPaths
+	{
+		UINT xTarget, yTarget;
+		UINT dwStamp;   //when stashed
+		std::vector<SQUARE> squares;
+		std::priority_queue<SORTPOINT> entrySquares;
+	};
+	std::vector<CachedPaths> cachedPaths;
+	UINT dwCacheStamp;
+
 	//This value is set for use when no obstacle-free path to the target exists,
 	//but a mostly-valid path needs to be calculated anyway.
 	UINT dwPathThroughObstacleCost;
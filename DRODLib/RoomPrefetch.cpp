@@ -0,0 +1,161 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 1995, 1996,
+ * 1997, 2000, 2001, 2002, 2005 Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+#include "RoomPrefetch.h"
+#include "DbLevels.h"
+#include "DbRooms.h"
+#include <BackEndLib/Assert.h>
+
+//*****************************************************************************
+CRoomPrefetch::CRoomPrefetch()
+	: dwLevelID(0)
+{
+}
+
+//*****************************************************************************
+CRoomPrefetch::CRoomPrefetch(const CRoomPrefetch&)
+//Prefetched rooms aren't copied.  A copy fetches its own on demand.
+	: dwLevelID(0)
+{
+}
+
+//*****************************************************************************
+CRoomPrefetch::~CRoomPrefetch()
+{
+	Clear();
+}
+
+//*****************************************************************************
+void CRoomPrefetch::Clear()
+//Frees all prefetched rooms.
+{
+	for (vector<PrefetchedRoom>::const_iterator iter = this->rooms.begin();
+			iter != this->rooms.end(); ++iter)
+		delete iter->pRoom;
+	this->rooms.clear();
+	this->dwLevelID = 0;
+}
+
+//*****************************************************************************
+bool CRoomPrefetch::PrefetchNext(
+//Loads one room bordering the room being played, if any have not been loaded yet.
+//Prefetched rooms no longer bordering the current room are freed.
+//
+//Returns: whether a room was looked up, i.e. there may be more work to do
+//
+//Params:
+	CDbLevel& level,     //(in) level being played
+	const CDbRoom& room) //(in) room being played
+{
+	if (level.dwLevelID != this->dwLevelID)
+	{
+		Clear();
+		this->dwLevelID = level.dwLevelID;
+	}
+	DiscardNonadjacentRooms(room.dwRoomX, room.dwRoomY);
+
+	static const int dx[4] = {0, 0, -1, 1};
+	static const int dy[4] = {-1, 1, 0, 0};
+	for (UINT i=0; i<4; ++i)
+	{
+		//No rooms lie beyond coordinate 0.
+		if ((!room.dwRoomX && dx[i] < 0) || (!room.dwRoomY && dy[i] < 0))
+			continue;
+
+		const UINT dwRoomX = room.dwRoomX + dx[i];
+		const UINT dwRoomY = room.dwRoomY + dy[i];
+		if (IsPrefetched(dwRoomX, dwRoomY))
+			continue;
+
+		//A NULL room is kept too, so missing neighbors aren't looked up again.
+		this->rooms.push_back(PrefetchedRoom(dwRoomX, dwRoomY,
+				level.GetRoomAtCoords(dwRoomX, dwRoomY)));
+		return true;
+	}
+
+	return false;
+}
+
+//*****************************************************************************
+CDbRoom* CRoomPrefetch::Take(
+//Returns: the prefetched room at these coords, which the caller now owns and
+//must delete, or NULL if the room hasn't been prefetched
+//
+//Params:
+	const UINT dwLevelID,                   //(in) level of room
+	const UINT dwRoomX, const UINT dwRoomY) //(in) coords of room
+{
+	if (dwLevelID != this->dwLevelID)
+		return NULL;
+
+	for (vector<PrefetchedRoom>::iterator iter = this->rooms.begin();
+			iter != this->rooms.end(); ++iter)
+	{
+		if (iter->dwRoomX == dwRoomX && iter->dwRoomY == dwRoomY)
+		{
+			CDbRoom *pRoom = iter->pRoom;
+			if (!pRoom)
+				return NULL; //let caller look it up as usual
+			this->rooms.erase(iter);
+			return pRoom;
+		}
+	}
+
+	return NULL;
+}
+
+//*****************************************************************************
+void CRoomPrefetch::DiscardNonadjacentRooms(
+//Frees prefetched rooms that don't border the room at these coords.
+//
+//Params:
+	const UINT dwRoomX, const UINT dwRoomY) //(in) coords of room being played
+{
+	vector<PrefetchedRoom>::iterator iter = this->rooms.begin();
+	while (iter != this->rooms.end())
+	{
+		const UINT wDX = iter->dwRoomX > dwRoomX ? iter->dwRoomX - dwRoomX : dwRoomX - iter->dwRoomX;
+		const UINT wDY = iter->dwRoomY > dwRoomY ? iter->dwRoomY - dwRoomY : dwRoomY - iter->dwRoomY;
+		if (wDX + wDY == 1)
+		{
+			++iter;
+		} else {
+			delete iter->pRoom;
+			iter = this->rooms.erase(iter);
+		}
+	}
+}
+
+//*****************************************************************************
+bool CRoomPrefetch::IsPrefetched(const UINT dwRoomX, const UINT dwRoomY) const
+//Returns: whether the room at these coords has been looked up
+{
+	for (vector<PrefetchedRoom>::const_iterator iter = this->rooms.begin();
+			iter != this->rooms.end(); ++iter)
+		if (iter->dwRoomX == dwRoomX && iter->dwRoomY == dwRoomY)
+			return true;
+	return false;
+}
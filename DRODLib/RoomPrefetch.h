@@ -0,0 +1,79 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 1995, 1996,
+ * 1997, 2000, 2001, 2002, 2005 Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+//Rooms adjacent to the room being played, loaded ahead of time.
+//
+//When the player exits a room, the room being entered is normally loaded from
+//the DB (rows looked up, squares unpacked, monsters, orbs, scrolls, etc. read)
+//right then.  While the player is idle, the game screen asks the current game
+//to load the rooms bordering the current one, one room per call, so that a
+//room transition only has to take ownership of an already loaded room.
+//
+//Prefetching is done on the main thread between events, since the DB isn't
+//safe to access from more than one thread.  A prefetched room is exactly what
+//loading it at exit time would produce, so play is unaffected.
+
+#ifndef ROOMPREFETCH_H
+#define ROOMPREFETCH_H
+
+#include <BackEndLib/Types.h>
+
+#include <vector>
+using std::vector;
+
+class CDbLevel;
+class CDbRoom;
+
+//*****************************************************************************
+class CRoomPrefetch
+{
+public:
+	CRoomPrefetch();
+	CRoomPrefetch(const CRoomPrefetch&);
+	~CRoomPrefetch();
+	CRoomPrefetch& operator=(const CRoomPrefetch&) {Clear(); return *this;}
+
+	void     Clear();
+	bool     PrefetchNext(CDbLevel& level, const CDbRoom& room);
+	CDbRoom* Take(const UINT dwLevelID, const UINT dwRoomX, const UINT dwRoomY);
+
+private:
+	struct PrefetchedRoom
+	{
+		PrefetchedRoom(const UINT dwRoomX, const UINT dwRoomY, CDbRoom *pRoom)
+			: dwRoomX(dwRoomX), dwRoomY(dwRoomY), pRoom(pRoom) {}
+		UINT dwRoomX, dwRoomY;
+		CDbRoom *pRoom; //NULL when there is no room at these coords
+	};
+
+	void     DiscardNonadjacentRooms(const UINT dwRoomX, const UINT dwRoomY);
+	bool     IsPrefetched(const UINT dwRoomX, const UINT dwRoomY) const;
+
+	vector<PrefetchedRoom> rooms;
+	UINT dwLevelID;
+};
+
+#endif //...#ifndef ROOMPREFETCH_H
@@ -0,0 +1,368 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 1995, 1996,
+ * 1997, 2000, 2001, 2002, 2005 Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+#include "ScriptExpression.h"
+#include "Character.h"
+#include "CurrentGame.h"
+#include "DbHolds.h"
+#include "PlayerStats.h"
+
+#define SKIP_WHITESPACE(str, index) while (iswspace(str[index])) ++index
+
+//*****************************************************************************
+CScriptExpression::CScriptExpression()
+	: pHold(NULL)
+	, wStackDepth(0), wMaxStackDepth(0)
+	, bCompiled(false)
+{
+}
+
+//*****************************************************************************
+bool CScriptExpression::Compile(
+//Translates the expression text into postfix code.
+//The grammar and evaluation order are those of CCharacter::parseExpression.
+//
+//Returns: whether the text is a well-formed expression that was compiled
+//
+//Params:
+	const WCHAR *pwStr,    //(in) expression text
+	const CDbHold *pHold)  //(in) hold whose vars the expression may reference
+{
+	ASSERT(pwStr);
+	this->code.clear();
+	this->localVarNames.clear();
+	this->pHold = pHold;
+	this->wStackDepth = this->wMaxStackDepth = 0;
+
+	UINT index = 0;
+	this->bCompiled = CompileExpression(pwStr, index, false) &&
+			this->wMaxStackDepth <= MAX_STACK_DEPTH;
+	ASSERT(!this->bCompiled || this->wStackDepth == 1);
+
+	this->pHold = NULL;
+	if (!this->bCompiled)
+		this->code.clear();
+	return this->bCompiled;
+}
+
+//*****************************************************************************
+int CScriptExpression::Evaluate(
+//Returns: the value of the compiled expression in the current game state
+//
+//Params:
+	CCurrentGame *pGame, //(in) game whose vars are read
+	CCharacter *pNPC)    //(in) NPC evaluating the expression, or NULL
+const
+{
+	ASSERT(this->bCompiled);
+	ASSERT(pGame);
+
+	int stack[MAX_STACK_DEPTH];
+	UINT top = 0;
+
+	for (vector<ExpressionInstruction>::const_iterator instr = this->code.begin();
+			instr != this->code.end(); ++instr)
+	{
+		switch (instr->op)
+		{
+			case EO_Constant:
+				stack[top++] = instr->operand;
+			break;
+			case EO_PredefinedVar:
+			{
+				const UINT eVar = UINT(instr->operand);
+				stack[top++] = pNPC ? int(pNPC->getPredefinedVarInt(eVar)) : int(pGame->getVar(eVar));
+			}
+			break;
+			case EO_LocalVar:
+				stack[top++] = pNPC ? pNPC->getLocalVarInt(this->localVarNames[instr->operand]) : 0;
+			break;
+			case EO_HoldVar:
+			{
+				const UINT dwVarID = UINT(instr->operand);
+				const UNPACKEDVARTYPE vType = pGame->stats.GetHoldVarType(dwVarID);
+				const bool bValidInt = vType == UVT_int || vType == UVT_uint || vType == UVT_unknown;
+				stack[top++] = bValidInt ? pGame->stats.GetHoldVarInt(dwVarID) : 0;
+			}
+			break;
+			case EO_Negate:
+				stack[top-1] = -stack[top-1];
+			break;
+			case EO_Add:
+				--top;
+				stack[top-1] += stack[top];
+			break;
+			case EO_Subtract:
+				--top;
+				stack[top-1] -= stack[top];
+			break;
+			case EO_Multiply:
+				--top;
+				stack[top-1] *= stack[top];
+			break;
+			case EO_Divide:
+				--top;
+				if (stack[top]) //no divide by zero
+					stack[top-1] /= stack[top];
+			break;
+			case EO_Modulo:
+				--top;
+				if (stack[top]) //no mod by zero
+					stack[top-1] %= stack[top];
+			break;
+			default: ASSERT(!"Unknown expression op"); break;
+		}
+	}
+
+	ASSERT(top == 1);
+	return stack[0];
+}
+
+//*****************************************************************************
+bool CScriptExpression::CompileExpression(
+//expression = ["+"|"-"] term {("+"|"-") term}
+//
+//Params:
+	const WCHAR *pwStr, UINT& index,
+	const bool bExpectCloseParen) //whether a close paren marks the end of this (nested) expression
+{
+	SKIP_WHITESPACE(pwStr, index);
+
+	bool bAdd = true; //otherwise subtract
+	if (pwStr[index] == W_t('+'))
+		++index;
+	else if (pwStr[index] == W_t('-'))
+	{
+		bAdd = false;
+		++index;
+	}
+
+	if (!CompileTerm(pwStr, index))
+		return false;
+	if (!bAdd)
+		Emit(EO_Negate);
+
+	SKIP_WHITESPACE(pwStr, index);
+	while (pwStr[index]!=0)
+	{
+		if (pwStr[index] == W_t('+'))
+		{
+			bAdd = true;
+			++index;
+		}
+		else if (pwStr[index] == W_t('-'))
+		{
+			bAdd = false;
+			++index;
+		}
+		else if (bExpectCloseParen && pwStr[index] == W_t(')'))
+			return true; //caller will parse the close paren
+		else
+			return false; //bad symbol
+
+		if (!CompileTerm(pwStr, index))
+			return false;
+		Emit(bAdd ? EO_Add : EO_Subtract);
+	}
+
+	return true;
+}
+
+//*****************************************************************************
+bool CScriptExpression::CompileTerm(const WCHAR *pwStr, UINT& index)
+//term = factor {("*"|"/"|"%") factor}
+{
+	if (!CompileFactor(pwStr, index))
+		return false;
+
+	while (pwStr[index]!=0)
+	{
+		SKIP_WHITESPACE(pwStr, index);
+
+		ExpressionOp op;
+		if (pwStr[index] == W_t('*'))
+			op = EO_Multiply;
+		else if (pwStr[index] == W_t('/'))
+			op = EO_Divide;
+		else if (pwStr[index] == W_t('%'))
+			op = EO_Modulo;
+		else
+			return true; //no more factors in this term
+		++index;
+
+		if (!CompileFactor(pwStr, index))
+			return false;
+		Emit(op);
+	}
+
+	return true;
+}
+
+//*****************************************************************************
+bool CScriptExpression::CompileFactor(const WCHAR *pwStr, UINT& index)
+//factor = var | number | "(" expression ")"
+{
+	SKIP_WHITESPACE(pwStr, index);
+
+	//A nested expression?
+	if (pwStr[index] == W_t('('))
+	{
+		++index;
+		if (!CompileExpression(pwStr, index, true))
+			return false;
+		SKIP_WHITESPACE(pwStr, index);
+		if (pwStr[index] != W_t(')'))
+			return false; //missing close parenthesis
+		++index;
+		return true;
+	}
+
+	//Number?
+	if (iswdigit(pwStr[index]))
+	{
+		const int val = _Wtoi(pwStr + index);
+
+		++index;
+		while (iswdigit(pwStr[index]))
+			++index;
+
+		if (iswalpha(pwStr[index]))
+			return false; //invalid var name of the form <digits><alphas>
+
+		Emit(EO_Constant, val);
+		return true;
+	}
+
+	//Variable identifier?
+	if (pwStr[index] == W_t('_') || iswalpha(pwStr[index]) || pwStr[index] == W_t('.'))
+	{
+		//Find spot where var identifier ends.
+		UINT endIndex = index + 1;
+		UINT spcTrail = 0;
+		while (CDbHold::IsVarCharValid(pwStr[endIndex]))
+		{
+			if (pwStr[endIndex] == W_t(' '))
+				++spcTrail;
+			else
+				spcTrail = 0;
+			++endIndex;
+		}
+
+		const WSTRING wVarName(pwStr + index, endIndex - index - spcTrail);
+		index = endIndex;
+
+		const ScriptVars::Predefined eVar = ScriptVars::parsePredefinedVar(wVarName);
+		if (eVar != ScriptVars::P_NoVar)
+		{
+			//String vars have no integer value.
+			if (ScriptVars::IsStringVar(eVar))
+				Emit(EO_Constant, 0);
+			else
+				Emit(EO_PredefinedVar, int(eVar));
+		} else if (ScriptVars::IsCharacterLocalVar(wVarName)) {
+			Emit(EO_LocalVar, int(this->localVarNames.size()));
+			this->localVarNames.push_back(wVarName);
+		} else {
+			//A hold var.  Resolve its ID now instead of on each evaluation.
+			if (!this->pHold)
+				return false;
+			Emit(EO_HoldVar, int(this->pHold->GetVarID(wVarName.c_str())));
+		}
+		return true;
+	}
+
+	//Invalid identifier
+	return false;
+}
+
+//*****************************************************************************
+void CScriptExpression::Emit(const ExpressionOp op, const int operand) //[default=0]
+//Appends an instruction, tracking the stack depth it requires.
+{
+	this->code.push_back(ExpressionInstruction(op, operand));
+	switch (op)
+	{
+		case EO_Constant: case EO_PredefinedVar: case EO_LocalVar: case EO_HoldVar:
+			if (++this->wStackDepth > this->wMaxStackDepth)
+				this->wMaxStackDepth = this->wStackDepth;
+		break;
+		case EO_Negate:
+		break;
+		default:
+			ASSERT(this->wStackDepth >= 2);
+			--this->wStackDepth;
+		break;
+	}
+}
+
+//
+//CScriptExpressionCache
+//
+
+//*****************************************************************************
+CScriptExpressionCache::CScriptExpressionCache()
+	: pHold(NULL), dwHoldID(0), wHoldVarCount(0)
+{
+}
+
+//*****************************************************************************
+void CScriptExpressionCache::Clear()
+{
+	this->expressions.clear();
+	this->pHold = NULL;
+	this->dwHoldID = 0;
+	this->wHoldVarCount = 0;
+}
+
+//*****************************************************************************
+const CScriptExpression& CScriptExpressionCache::Get(
+//Returns: the compiled form of the expression text, compiling it on first use.
+//If the text could not be compiled, the returned expression's IsCompiled() is false.
+//
+//Params:
+	const WSTRING& wstrExpression, //(in) expression text
+	const CDbHold *pHold)          //(in) hold being played
+{
+	//Hold var IDs are only valid for the hold and var list they were compiled against.
+	const UINT dwHoldID = pHold ? pHold->dwHoldID : 0;
+	const UINT wHoldVarCount = pHold ? pHold->vars.size() : 0;
+	if (pHold != this->pHold || dwHoldID != this->dwHoldID ||
+			wHoldVarCount != this->wHoldVarCount)
+	{
+		this->expressions.clear();
+		this->pHold = pHold;
+		this->dwHoldID = dwHoldID;
+		this->wHoldVarCount = wHoldVarCount;
+	}
+
+	std::map<WSTRING, CScriptExpression>::iterator found = this->expressions.find(wstrExpression);
+	if (found != this->expressions.end())
+		return found->second;
+
+	CScriptExpression& expression = this->expressions[wstrExpression];
+	expression.Compile(wstrExpression.c_str(), pHold);
+	return expression;
+}
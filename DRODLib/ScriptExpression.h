@@ -0,0 +1,123 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 1995, 1996,
+ * 1997, 2000, 2001, 2002, 2005 Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+//Compiled form of the integer expressions used in NPC scripts.
+//
+//CCharacter::parseExpression re-tokenizes the expression text, re-resolves each
+//identifier and re-looks up each hold var's ID every time a script command is
+//evaluated.  A CScriptExpression does that work once, translating the text into
+//a short postfix program that evaluates against the current game state.
+//Expressions are compiled lazily and cached per hold by CScriptExpressionCache.
+//
+//Only well-formed expressions are compiled.  Text that would produce a parse
+//error is left uncompiled so callers fall back to parseExpression, which
+//reports the error and yields the same partial value it always has.
+
+#ifndef SCRIPTEXPRESSION_H
+#define SCRIPTEXPRESSION_H
+#ifdef WIN32
+#  pragma warning(disable:4786)
+#endif
+
+#include <BackEndLib/Types.h>
+#include <BackEndLib/Wchar.h>
+
+#include <map>
+#include <vector>
+using std::vector;
+
+class CCharacter;
+class CCurrentGame;
+class CDbHold;
+
+//Postfix operations.
+enum ExpressionOp
+{
+	EO_Constant=0,    //push operand
+	EO_PredefinedVar, //push value of predefined var #operand
+	EO_LocalVar,      //push value of NPC local var localVarNames[operand]
+	EO_HoldVar,       //push value of hold var with ID operand
+	EO_Negate,        //negate top of stack
+	EO_Add,           //binary operations pop two values and push the result
+	EO_Subtract,
+	EO_Multiply,
+	EO_Divide,        //no divide by zero
+	EO_Modulo         //no mod by zero
+};
+
+struct ExpressionInstruction
+{
+	ExpressionInstruction(const ExpressionOp op, const int operand=0)
+		: op(op), operand(operand) {}
+	ExpressionOp op;
+	int operand;
+};
+
+//*****************************************************************************
+class CScriptExpression
+{
+public:
+	CScriptExpression();
+
+	bool  Compile(const WCHAR *pwStr, const CDbHold *pHold);
+	int   Evaluate(CCurrentGame *pGame, CCharacter *pNPC) const;
+	bool  IsCompiled() const {return this->bCompiled;}
+
+	static const UINT MAX_STACK_DEPTH = 32;
+
+private:
+	bool  CompileExpression(const WCHAR *pwStr, UINT& index, const bool bExpectCloseParen);
+	bool  CompileTerm(const WCHAR *pwStr, UINT& index);
+	bool  CompileFactor(const WCHAR *pwStr, UINT& index);
+	void  Emit(const ExpressionOp op, const int operand=0);
+
+	vector<ExpressionInstruction> code;
+	vector<WSTRING> localVarNames;
+
+	const CDbHold *pHold;  //used only while compiling
+	UINT wStackDepth, wMaxStackDepth;
+	bool bCompiled;
+};
+
+//*****************************************************************************
+class CScriptExpressionCache
+{
+public:
+	CScriptExpressionCache();
+
+	void  Clear();
+	const CScriptExpression& Get(const WSTRING& wstrExpression, const CDbHold *pHold);
+
+private:
+	std::map<WSTRING, CScriptExpression> expressions;
+
+	//Compiled hold var IDs depend on the hold's var list.
+	const CDbHold *pHold;
+	UINT dwHoldID;
+	UINT wHoldVarCount;
+};
+
+#endif //...#ifndef SCRIPTEXPRESSION_H
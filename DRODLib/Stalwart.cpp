@@ -113,7 +113,7 @@ const
 		return true;
 
 	//Can't step on any swords.
-	if (this->swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
+	if (GetPathSearchContext().swordsInRoom.Exists(wCol, wRow)) //this set is compiled at beginning of move
 		return true;
 
 	//Player can never be stepped on.
@@ -226,7 +226,7 @@ bool CStalwart::GetGoal(UINT& wX, UINT& wY)
 
 	//Each turn, find the optimal path to the closest monster.
 	//Optimization: get all sword coords once for pathmap search.
-	this->pCurrentGame->pRoom->GetSwordCoords(this->swordsInRoom, true, false, this);
+	this->pCurrentGame->pRoom->GetSwordCoords(GetPathSearchContext().swordsInRoom, true, false, this);
 	this->pathToDest.Clear();
 	if (!FindOptimalPathToClosestMonster(this->wX, this->wY, CStalwart::typesToAttack))
 		return false;  //no path is available
@@ -0,0 +1,55 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Every heap allocation in the test executable is counted, so benchmarks can
+// report how many allocations game processing makes per turn.
+static std::atomic<unsigned long> allocationCount(0);
+
+void* operator new(std::size_t size){
+	++allocationCount;
+	void *p = malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](std::size_t size){
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept{
+	free(p);
+}
+
+Benchmark::Benchmark(const std::string& name)
+	: name(name), startAllocations(0)
+{
+}
+
+void Benchmark::Start(){
+	this->startAllocations = GetAllocationCount();
+	this->startTime = std::chrono::steady_clock::now();
+}
+
+void Benchmark::Stop(const UINT count, const char* unit){
+	const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+	const unsigned long allocations = GetAllocationCount() - this->startAllocations;
+	const double seconds = std::chrono::duration<double>(endTime - this->startTime).count();
+
+	const double perSecond = seconds > 0.0 ? count / seconds : 0.0;
+	const double allocationsPerUnit = count ? double(allocations) / count : 0.0;
+	printf("%-44s %6u %ss %12.1f %ss/sec %10.1f allocs/%s\n",
+			this->name.c_str(), count, unit, perSecond, unit, allocationsPerUnit, unit);
+}
+
+unsigned long Benchmark::GetAllocationCount(){
+	return allocationCount;
+}
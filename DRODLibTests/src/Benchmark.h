@@ -0,0 +1,26 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <BackEndLib/Types.h>
+#include <chrono>
+#include <string>
+
+// Times a stretch of game processing (or rendering) and counts the heap
+// allocations made during it. Results are written to stdout when the timer is
+// stopped, per turn or per whatever unit of work is named.
+class Benchmark{
+public:
+	Benchmark(const std::string& name);
+
+	void Start();
+	void Stop(const UINT count, const char* unit = "turn");
+
+	static unsigned long GetAllocationCount();
+
+private:
+	std::string name;
+	std::chrono::steady_clock::time_point startTime;
+	unsigned long startAllocations;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "../../catch.hpp"
+#include "../../Benchmark.h"
+#include "../../../../FrontEndLib/ImageDecoder.h"
+#include <BackEndLib/Files.h>
+
+#include <SDL.h>
+#include <string.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Hidden from the default test run. Run with: DRODLibTest "[benchmark]"
+//
+// Decodes every PNG and JPEG tile sheet and texture in the Bitmaps resource
+// directory, as loading styles at startup does. Decoding them one after
+// another, as the LoadImageSurface loop did, is timed against decoding them
+// on several threads, as LoadImageSurfaces does. Conversion to the display
+// format needs a window, so it isn't included in either.
+
+namespace {
+	const UINT ROUNDS = 3;
+	const UINT MAX_THREADS = 8; // as in LoadImageSurfaces
+
+	void AddJobs(vector<CImageDecoder::Job>& jobs, const WSTRING& wstrPath, const char* pszExtension, const UINT wFormat){
+		vector<WSTRING> files;
+		WSTRING wstrMask;
+		AsciiToUnicode(pszExtension, wstrMask);
+		CFiles::GetFileList(wstrPath.c_str(), wstrMask, files, true);
+		for (vector<WSTRING>::const_iterator file = files.begin(); file != files.end(); ++file)
+			jobs.push_back(CImageDecoder::Job(*file, wFormat));
+	}
+
+	void FreeJobs(vector<CImageDecoder::Job>& jobs){
+		for (vector<CImageDecoder::Job>::iterator job = jobs.begin(); job != jobs.end(); ++job)
+			CImageDecoder::Free(*job);
+	}
+
+	bool SurfacesMatch(const SDL_Surface* pA, const SDL_Surface* pB){
+		if (!pA || !pB)
+			return pA == pB;
+		if (pA->w != pB->w || pA->h != pB->h || pA->pitch != pB->pitch ||
+				pA->format->BytesPerPixel != pB->format->BytesPerPixel)
+			return false;
+		const UINT wRowBytes = pA->w * pA->format->BytesPerPixel;
+		for (int y = 0; y < pA->h; ++y)
+			if (memcmp((const Uint8*)pA->pixels + y * pA->pitch,
+					(const Uint8*)pB->pixels + y * pB->pitch, wRowBytes) != 0)
+				return false;
+		return true;
+	}
+}
+
+TEST_CASE("Style image decoding benchmarks", "[.][benchmark]") {
+	static const WCHAR wszBitmaps[] = { We(SLASH),We('B'),We('i'),We('t'),We('m'),We('a'),We('p'),We('s'),We(0) };
+	WSTRING wstrBitmapsPath = CFiles::GetResPath();
+	wstrBitmapsPath += wszBitmaps;
+
+	vector<CImageDecoder::Job> files;
+	AddJobs(files, wstrBitmapsPath, "png", DATA_PNG);
+	AddJobs(files, wstrBitmapsPath, "jpg", DATA_JPG);
+	if (files.empty()){
+		WARN("No images found in " << CFiles::UnicodeToCPath(wstrBitmapsPath));
+		return;
+	}
+
+	vector<CImageDecoder::Job> serialJobs, parallelJobs;
+	for (UINT wRound = 0; wRound < ROUNDS; ++wRound){
+		FreeJobs(serialJobs);
+		serialJobs = files;
+		Benchmark serial("Decode one at a time");
+		serial.Start();
+		CImageDecoder::Decode(serialJobs, 1);
+		serial.Stop(serialJobs.size(), "image");
+
+		FreeJobs(parallelJobs);
+		parallelJobs = files;
+		Benchmark parallel("Decode on up to 8 threads");
+		parallel.Start();
+		CImageDecoder::Decode(parallelJobs, MAX_THREADS);
+		parallel.Stop(parallelJobs.size(), "image");
+	}
+
+	for (UINT wI = 0; wI < files.size(); ++wI){
+		INFO(CFiles::UnicodeToCPath(files[wI].wstrFilepath));
+		REQUIRE(serialJobs[wI].pSurface);
+		REQUIRE(SurfacesMatch(serialJobs[wI].pSurface, parallelJobs[wI].pSurface));
+	}
+	FreeJobs(serialJobs);
+	FreeJobs(parallelJobs);
+}
@@ -0,0 +1,155 @@
+#include "../../catch.hpp"
+#include "../../Benchmark.h"
+#include "../../../../FrontEndLib/RowKernels.h"
+
+#include <string>
+#include <vector>
+using namespace std;
+
+// Hidden from the default test run. Run with: DRODLibTest "[benchmark]"
+//
+// Lights and shades a 1920x1080 32-bit frame tile by tile, the way room
+// lighting is applied to the room surface. Each way of doing it is timed over
+// the same frames:
+// - the per-byte float loop LightenRectWithTileMask used before the row kernels,
+// - the row kernels' scalar code alone,
+// - the row kernels as built (SSE2 where the compiler targets it).
+
+namespace {
+	const UINT FRAME_WIDTH = 1920, FRAME_HEIGHT = 1080, FRAME_PITCH = FRAME_WIDTH * 4;
+	const UINT TILE_SIZE = 44;
+	const UINT TILE_COLS = (FRAME_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+	const UINT TILE_ROWS = (FRAME_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+	const UINT FRAMES = 60;
+	const Uint8 TRANS_COLOR[3] = {192, 192, 192};
+
+	// Byte offsets of the color channels in a pixel.
+	const UINT R_BYTE = 2, G_BYTE = 1, B_BYTE = 0;
+
+	enum LightingCode {LC_Float, LC_Scalar, LC_Kernel};
+
+	struct Frame {
+		Frame() : pixels(FRAME_PITCH * FRAME_HEIGHT), mask(TILE_SIZE * TILE_SIZE * 4) {
+			UINT seed = 3;
+			for (UINT i = 0; i < this->pixels.size(); ++i){
+				seed = seed * 1103515245 + 12345;
+				this->pixels[i] = Uint8(seed >> 16);
+			}
+
+			// A round light mask: transparent outside the circle.
+			for (UINT y = 0; y < TILE_SIZE; ++y)
+				for (UINT x = 0; x < TILE_SIZE; ++x){
+					const int dx = int(x) - int(TILE_SIZE / 2), dy = int(y) - int(TILE_SIZE / 2);
+					const bool bLit = dx * dx + dy * dy < int(TILE_SIZE * TILE_SIZE / 4);
+					Uint8 *pMask = &this->mask[(y * TILE_SIZE + x) * 4];
+					for (UINT i = 0; i < 3; ++i)
+						pMask[PIXEL_FUDGE_FACTOR + i] = bLit ? 255 : TRANS_COLOR[i];
+				}
+
+			// Light strength varies from tile to tile; some tiles are darkened.
+			for (UINT tile = 0; tile < TILE_COLS * TILE_ROWS; ++tile){
+				seed = seed * 1103515245 + 12345;
+				this->lights.push_back(0.5f + (seed >> 16) % 1500 / 1000.0f);
+			}
+		}
+
+		vector<Uint8> pixels;
+		vector<Uint8> mask;
+		vector<float> lights;
+	};
+
+	// The loop LightenRectWithTileMask ran before it used the row kernels.
+	void LightTileFloat(Uint8 *pSeek, const Uint8 *pMask, const UINT w, const UINT h,
+			const float R, const float G, const float B)
+	{
+		for (UINT y = 0; y < h; ++y, pSeek += FRAME_PITCH - w * 4, pMask += (TILE_SIZE - w) * 4)
+			for (UINT x = 0; x < w; ++x, pSeek += 4, pMask += 4)
+			{
+				if (pMask[0] != TRANS_COLOR[0] || pMask[1] != TRANS_COLOR[1] || pMask[2] != TRANS_COLOR[2])
+				{
+					UINT wVal = (UINT)(pSeek[R_BYTE] * R);
+					pSeek[R_BYTE] = (unsigned char)(wVal < 255 ? wVal : 255);
+					wVal = (UINT)(pSeek[G_BYTE] * G);
+					pSeek[G_BYTE] = (unsigned char)(wVal < 255 ? wVal : 255);
+					wVal = (UINT)(pSeek[B_BYTE] * B);
+					pSeek[B_BYTE] = (unsigned char)(wVal < 255 ? wVal : 255);
+				}
+			}
+	}
+
+	void LightFrame(Frame& frame, const LightingCode code){
+		const PixelKey32 key(TRANS_COLOR);
+		for (UINT row = 0; row < TILE_ROWS; ++row)
+			for (UINT col = 0; col < TILE_COLS; ++col){
+				const UINT x = col * TILE_SIZE, y = row * TILE_SIZE;
+				const UINT w = x + TILE_SIZE <= FRAME_WIDTH ? TILE_SIZE : FRAME_WIDTH - x;
+				const UINT h = y + TILE_SIZE <= FRAME_HEIGHT ? TILE_SIZE : FRAME_HEIGHT - y;
+				const float light = frame.lights[row * TILE_COLS + col];
+				Uint8 *pTile = &frame.pixels[y * FRAME_PITCH + x * 4];
+
+				if (code == LC_Float){
+					LightTileFloat(pTile, &frame.mask[0], w, h, light, light, light);
+					continue;
+				}
+
+				Uint16 factors[4] = {256, 256, 256, 256};
+				factors[R_BYTE] = factors[G_BYTE] = factors[B_BYTE] = CRowKernels::FixedPoint8_8(light);
+				for (UINT wRow = 0; wRow < h; ++wRow){
+					Uint8 *pRow = pTile + wRow * FRAME_PITCH;
+					const Uint8 *pMaskRow = &frame.mask[wRow * TILE_SIZE * 4];
+					if (code == LC_Scalar)
+						CRowKernels::ScaleRow32Scalar(pRow, pMaskRow, key, w, factors);
+					else
+						CRowKernels::ScaleRow32(pRow, pMaskRow, key, w, factors);
+				}
+			}
+	}
+
+	void ShadeFrame(Frame& frame, const bool bScalar){
+		const Uint8 colorBytes[4] = {40, 80, 160, 0};
+		const Uint8 byteMask[4] = {0xff, 0xff, 0xff, 0};
+		for (UINT y = 0; y < FRAME_HEIGHT; ++y){
+			Uint8 *pRow = &frame.pixels[y * FRAME_PITCH];
+			for (UINT x = 0; x < FRAME_WIDTH; x += TILE_SIZE){
+				const UINT w = x + TILE_SIZE <= FRAME_WIDTH ? TILE_SIZE : FRAME_WIDTH - x;
+				if (bScalar)
+					CRowKernels::ShadeRow32Scalar(pRow + x * 4, w, colorBytes, byteMask);
+				else
+					CRowKernels::ShadeRow32(pRow + x * 4, w, colorBytes, byteMask);
+			}
+		}
+	}
+}
+
+TEST_CASE("1080p lighting benchmarks", "[.][benchmark]") {
+	SECTION("Light tiles with a mask") {
+		const char* names[] = {"1080p lighting: float loop", "1080p lighting: scalar kernel", "1080p lighting: row kernel"};
+		vector<Frame> frames(3);
+		for (UINT code = LC_Float; code <= LC_Kernel; ++code){
+			Benchmark lighting(names[code]);
+			lighting.Start();
+			for (UINT i = 0; i < FRAMES; ++i)
+				LightFrame(frames[code], LightingCode(code));
+			lighting.Stop(FRAMES, "frame");
+		}
+		REQUIRE(frames[LC_Kernel].pixels == frames[LC_Scalar].pixels);
+	}
+
+	SECTION("Shade tiles") {
+		Frame scalarFrame, kernelFrame;
+
+		Benchmark scalar("1080p shading: scalar kernel");
+		scalar.Start();
+		for (UINT i = 0; i < FRAMES; ++i)
+			ShadeFrame(scalarFrame, true);
+		scalar.Stop(FRAMES, "frame");
+
+		Benchmark kernel("1080p shading: row kernel");
+		kernel.Start();
+		for (UINT i = 0; i < FRAMES; ++i)
+			ShadeFrame(kernelFrame, false);
+		kernel.Stop(FRAMES, "frame");
+
+		REQUIRE(kernelFrame.pixels == scalarFrame.pixels);
+	}
+}
@@ -0,0 +1,122 @@
+#include "../../catch.hpp"
+#include "../../CTestDb.h"
+#include "../../Runner.h"
+#include "../../RoomBuilder.h"
+#include "../../Benchmark.h"
+#include "../../../../DRODLib/CurrentGame.h"
+#include "../../../../DRODLib/Serpent.h"
+
+#include <string>
+using namespace std;
+
+// Hidden from the default test run. Run with: DRODLibTest "[benchmark]"
+//
+// Each room is played for a fixed number of turns while the player turns in
+// place inside a walled-off corner, so every monster keeps moving for the whole
+// run. Processing, replay and undo speed are reported for each room density.
+
+namespace {
+	struct RoomDensity {
+		const char* name;
+		UINT roachSpacing; // distance between roaches in the roach field
+		UINT serpents;     // up to 4
+		UINT brains;       // up to 8
+		UINT fuseRows;     // up to 3
+	};
+
+	const UINT PLAYED_TURNS = 500;
+	const UINT UNDONE_TURNS = 50;
+
+	void BuildRoom(const RoomDensity& density){
+		RoomBuilder::ClearRoom();
+
+		// Player's cell, out of reach of every monster.
+		RoomBuilder::PlotRect(T_WALL, 0, 0, 4, 4);
+		RoomBuilder::PlotRect(T_FLOOR, 1, 1, 3, 3);
+
+		// Roach field.
+		for (UINT wY = 6; wY <= 20; wY += density.roachSpacing)
+			for (UINT wX = 6; wX <= 36; wX += density.roachSpacing)
+				RoomBuilder::AddMonster(M_ROACH, wX, wY);
+
+		// Brains make the roaches follow pathmaps to the player.
+		for (UINT i = 0; i < density.brains; ++i)
+			RoomBuilder::AddMonster(M_BRAIN, 8 + 2 * i, 4);
+
+		// Serpents, heads facing west with their bodies trailing east.
+		for (UINT i = 0; i < density.serpents; ++i){
+			const UINT wY = 22 + 2 * i;
+			CSerpent* pSerpent = DYN_CAST(CSerpent*, CMonster*, RoomBuilder::AddMonster(M_SERPENT, 8, wY, W));
+			for (UINT wX = 9; wX <= 12; ++wX)
+				RoomBuilder::AddSerpentPiece(pSerpent, wX, wY);
+		}
+
+		// Tarstuff with a mother to keep it growing.
+		RoomBuilder::PlotRect(T_TAR, 20, 24, 28, 30);
+		RoomBuilder::AddMonster(M_TARMOTHER, 24, 27);
+
+		// Briar roots.
+		RoomBuilder::Plot(T_BRIAR_SOURCE, 36, 23);
+		RoomBuilder::Plot(T_BRIAR_SOURCE, 36, 30);
+
+		// Fuses, lit when a script sets off the bomb at their end.
+		for (UINT i = 0; i < density.fuseRows; ++i){
+			RoomBuilder::PlotRect(T_FUSE, 8, 1 + i, 33, 1 + i);
+			RoomBuilder::Plot(T_BOMB, 34, 1 + i);
+		}
+		if (density.fuseRows){
+			CCharacter* pCharacter = RoomBuilder::AddCharacter(37, 0);
+			RoomBuilder::AddCommand(pCharacter, CCharacterCommand::CC_Wait, 5);
+			RoomBuilder::AddCommand(pCharacter, CCharacterCommand::CC_AttackTile, 34, 1, 0, 0, ScriptFlag::AT_Stab);
+		}
+	}
+
+	void RunBenchmarks(const RoomDensity& density){
+		BuildRoom(density);
+		CCurrentGame* pGame = Runner::StartGame(2, 2, S);
+		CCueEvents CueEvents;
+
+		Benchmark processCommand(string(density.name) + ": ProcessCommand");
+		processCommand.Start();
+		for (UINT i = 0; i < PLAYED_TURNS; ++i){
+			CueEvents.Clear();
+			pGame->ProcessCommand(i % 2 ? CMD_C : CMD_CC, CueEvents);
+		}
+		processCommand.Stop(PLAYED_TURNS);
+		REQUIRE(!pGame->IsPlayerDying());
+		REQUIRE(pGame->wTurnNo == PLAYED_TURNS);
+
+		Benchmark playAllCommands(string(density.name) + ": PlayAllCommands");
+		playAllCommands.Start();
+		CueEvents.Clear();
+		REQUIRE(pGame->PlayAllCommands(CueEvents));
+		playAllCommands.Stop(PLAYED_TURNS);
+		REQUIRE(pGame->wTurnNo == PLAYED_TURNS);
+
+		Benchmark undoCommands(string(density.name) + ": UndoCommands");
+		undoCommands.Start();
+		for (UINT i = 0; i < UNDONE_TURNS; ++i){
+			CueEvents.Clear();
+			pGame->UndoCommands(1, CueEvents);
+		}
+		undoCommands.Stop(UNDONE_TURNS);
+		REQUIRE(pGame->wTurnNo == PLAYED_TURNS - UNDONE_TURNS);
+	}
+}
+
+TEST_CASE("Room simulation benchmarks", "[.][benchmark]") {
+	SECTION("Sparse room"){
+		const RoomDensity density = {"Sparse", 6, 1, 1, 1};
+		RunBenchmarks(density);
+	}
+
+	SECTION("Medium room"){
+		const RoomDensity density = {"Medium", 3, 2, 2, 2};
+		RunBenchmarks(density);
+	}
+
+	SECTION("Dense room"){
+		const RoomDensity density = {"Dense", 2, 4, 8, 3};
+		RunBenchmarks(density);
+	}
+}
@@ -0,0 +1,199 @@
+#include "../../catch.hpp"
+#include <BackEndLib/CoordSet.h>
+
+#include <set>
+#include <vector>
+using namespace std;
+
+namespace {
+	typedef set<ROOMCOORD> ReferenceSet;
+
+	// The coords in the set, as its iterators give them.
+	vector<ROOMCOORD> Members(const CCoordSet& coords){
+		vector<ROOMCOORD> members;
+		for (CCoordSet::const_iterator it = coords.begin(); it != coords.end(); ++it)
+			members.push_back(*it);
+		return members;
+	}
+
+	void RequireSameMembers(const CCoordSet& coords, const ReferenceSet& reference){
+		REQUIRE(coords.size() == int(reference.size()));
+		REQUIRE(coords.empty() == reference.empty());
+		REQUIRE(Members(coords) == vector<ROOMCOORD>(reference.begin(), reference.end()));
+	}
+
+	// Squares on both sides of the bitmap's edges, plus some far outside it.
+	vector<ROOMCOORD> EdgeCoords(){
+		const UINT edges[] = {0, 1, 37, 38, CCoordSet::BITMAP_COLS - 1, CCoordSet::BITMAP_COLS,
+				CCoordSet::BITMAP_COLS + 1, 1000, UINT(-1)};
+		const UINT count = sizeof(edges) / sizeof(edges[0]);
+		vector<ROOMCOORD> coords;
+		for (UINT x = 0; x < count; ++x)
+			for (UINT y = 0; y < count; ++y)
+				coords.push_back(ROOMCOORD(edges[x], edges[y]));
+		return coords;
+	}
+
+	// Deterministic pseudo-random coords, mostly inside a room.
+	vector<ROOMCOORD> ScatteredCoords(UINT seed, const UINT count){
+		vector<ROOMCOORD> coords;
+		for (UINT i = 0; i < count; ++i){
+			seed = seed * 1103515245 + 12345;
+			const UINT x = (seed >> 8) % 72;
+			seed = seed * 1103515245 + 12345;
+			const UINT y = (seed >> 8) % 72;
+			coords.push_back(ROOMCOORD(x, y));
+		}
+		return coords;
+	}
+}
+
+TEST_CASE("CCoordSet", "[containers]") {
+	SECTION("Insert, has and erase match std::set") {
+		CCoordSet coords;
+		ReferenceSet reference;
+		const vector<ROOMCOORD> added = ScatteredCoords(1, 600);
+		for (vector<ROOMCOORD>::const_iterator it = added.begin(); it != added.end(); ++it)
+			REQUIRE(coords.insert(*it) == reference.insert(*it).second);
+		RequireSameMembers(coords, reference);
+
+		for (UINT x = 0; x < 72; ++x)
+			for (UINT y = 0; y < 72; ++y)
+				REQUIRE(coords.has(x, y) == (reference.count(ROOMCOORD(x, y)) != 0));
+
+		const vector<ROOMCOORD> removed = ScatteredCoords(2, 600);
+		for (vector<ROOMCOORD>::const_iterator it = removed.begin(); it != removed.end(); ++it)
+			REQUIRE(coords.erase(*it) == (reference.erase(*it) != 0));
+		RequireSameMembers(coords, reference);
+	}
+
+	SECTION("Coords on and past the bitmap bounds") {
+		CCoordSet coords;
+		ReferenceSet reference;
+		const vector<ROOMCOORD> edges = EdgeCoords();
+		for (vector<ROOMCOORD>::const_reverse_iterator it = edges.rbegin(); it != edges.rend(); ++it){
+			REQUIRE(coords.insert(*it));
+			REQUIRE(!coords.insert(*it));
+			reference.insert(*it);
+		}
+		RequireSameMembers(coords, reference);
+
+		for (vector<ROOMCOORD>::const_iterator it = edges.begin(); it != edges.end(); ++it)
+			REQUIRE(coords.has(*it));
+		REQUIRE(!coords.has(CCoordSet::BITMAP_COLS - 2, CCoordSet::BITMAP_ROWS - 2));
+		REQUIRE(!coords.has(2000, 2000));
+
+		for (UINT i = 0; i < edges.size(); i += 2){
+			REQUIRE(coords.erase(edges[i]));
+			REQUIRE(!coords.erase(edges[i]));
+			reference.erase(edges[i]);
+		}
+		RequireSameMembers(coords, reference);
+	}
+
+	SECTION("Iteration interleaves bitmap and overflow coords in (x,y) order") {
+		CCoordSet coords;
+		coords.insert(5, 70);
+		coords.insert(5, 3);
+		coords.insert(70, 0);
+		coords.insert(6, 0);
+		coords.insert(5, 63);
+
+		const ROOMCOORD expected[] = {
+			ROOMCOORD(5, 3), ROOMCOORD(5, 63), ROOMCOORD(5, 70), ROOMCOORD(6, 0), ROOMCOORD(70, 0)};
+		REQUIRE(Members(coords) == vector<ROOMCOORD>(expected, expected + 5));
+
+		UINT wX, wY;
+		REQUIRE(coords.first(wX, wY));
+		REQUIRE(wX == 5);
+		REQUIRE(wY == 3);
+	}
+
+	SECTION("pop_first empties the set in order") {
+		CCoordSet coords;
+		ReferenceSet reference;
+		const vector<ROOMCOORD> edges = EdgeCoords();
+		for (vector<ROOMCOORD>::const_iterator it = edges.begin(); it != edges.end(); ++it){
+			coords.insert(*it);
+			reference.insert(*it);
+		}
+
+		UINT wX, wY;
+		for (ReferenceSet::const_iterator it = reference.begin(); it != reference.end(); ++it){
+			REQUIRE(coords.pop_first(wX, wY));
+			REQUIRE(ROOMCOORD(wX, wY) == *it);
+		}
+		REQUIRE(coords.empty());
+		REQUIRE(!coords.pop_first(wX, wY));
+		REQUIRE(!coords.first(wX, wY));
+		REQUIRE(coords.begin() == coords.end());
+	}
+
+	SECTION("Union and difference match std::set") {
+		CCoordSet a, b;
+		ReferenceSet refA, refB;
+		vector<ROOMCOORD> coords = ScatteredCoords(3, 300);
+		vector<ROOMCOORD> edges = EdgeCoords();
+		coords.insert(coords.end(), edges.begin(), edges.end());
+		for (UINT i = 0; i < coords.size(); ++i){
+			if (i % 3 != 0){ a.insert(coords[i]); refA.insert(coords[i]); }
+			if (i % 2 != 0){ b.insert(coords[i]); refB.insert(coords[i]); }
+		}
+
+		CCoordSet unionSet(a);
+		unionSet += b;
+		ReferenceSet refUnion(refA);
+		refUnion.insert(refB.begin(), refB.end());
+		RequireSameMembers(unionSet, refUnion);
+		unionSet += unionSet;
+		RequireSameMembers(unionSet, refUnion);
+
+		CCoordSet difference(a);
+		difference -= b;
+		ReferenceSet refDifference;
+		for (ReferenceSet::const_iterator it = refA.begin(); it != refA.end(); ++it)
+			if (!refB.count(*it))
+				refDifference.insert(*it);
+		RequireSameMembers(difference, refDifference);
+
+		difference += b;
+		RequireSameMembers(difference, refUnion);
+		difference -= difference;
+		RequireSameMembers(difference, ReferenceSet());
+
+		CCoordSet inserted;
+		inserted.insert(a.begin(), a.end());
+		RequireSameMembers(inserted, refA);
+	}
+
+	SECTION("Clear and reuse") {
+		CCoordSet coords(63, 63);
+		coords.insert(100, 2);
+		coords.clear();
+		RequireSameMembers(coords, ReferenceSet());
+		REQUIRE(!coords.has(63, 63));
+
+		coords.insert(0, 0);
+		ReferenceSet reference;
+		reference.insert(ROOMCOORD(0, 0));
+		RequireSameMembers(coords, reference);
+	}
+
+	SECTION("Conversion to and from CCoordIndex") {
+		CCoordIndex index(38, 32);
+		index.Add(0, 0);
+		index.Add(37, 31);
+		index.Add(12, 7);
+
+		CCoordSet coords;
+		coords = index;
+		const ROOMCOORD expected[] = {ROOMCOORD(0, 0), ROOMCOORD(12, 7), ROOMCOORD(37, 31)};
+		REQUIRE(Members(coords) == vector<ROOMCOORD>(expected, expected + 3));
+
+		CCoordIndex copy(38, 32);
+		coords.AddTo(copy);
+		for (UINT x = 0; x < 38; ++x)
+			for (UINT y = 0; y < 32; ++y)
+				REQUIRE(copy.Exists(x, y) == index.Exists(x, y));
+	}
+}
@@ -0,0 +1,193 @@
+#include "../../catch.hpp"
+#include "../../../../DRODLib/DbPackedVars.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Hold vars named "v<ID>" with int, UINT or text values are kept in a table indexed
+// by ID, but must behave exactly as vars kept by name do.
+
+namespace {
+	WSTRING Text(const char* pszText){
+		WSTRING wstr;
+		AsciiToUnicode(pszText, wstr);
+		return wstr;
+	}
+
+	bool HasText(const CDbPackedVars& vars, const char* pszVarName, const char* pszText){
+		const WCHAR* pwczValue = vars.GetVar(pszVarName, (const WCHAR*)NULL);
+		return pwczValue && WSTRING(pwczValue) == Text(pszText);
+	}
+
+	vector<BYTE> Pack(const CDbPackedVars& vars){
+		UINT dwSize;
+		BYTE* pBuf = vars.GetPackedBuffer(dwSize);
+		const vector<BYTE> buffer(pBuf, pBuf + dwSize);
+		delete[] pBuf;
+		return buffer;
+	}
+
+	// Names of the vars in a packed buffer, in packed order.
+	vector<string> PackedNames(const vector<BYTE>& buffer){
+		vector<string> names;
+		UINT pos = 0, dwNameSize;
+		memcpy(&dwNameSize, &buffer[pos], sizeof(UINT));
+		while (dwNameSize){
+			pos += sizeof(UINT);
+			names.push_back(string((const char*)&buffer[pos]));
+			pos += dwNameSize + sizeof(int);
+			UINT dwValueSize;
+			memcpy(&dwValueSize, &buffer[pos], sizeof(UINT));
+			pos += sizeof(UINT) + dwValueSize;
+			memcpy(&dwNameSize, &buffer[pos], sizeof(UINT));
+		}
+		return names;
+	}
+
+	vector<string> IteratedNames(CDbPackedVars& vars){
+		vector<string> names;
+		for (UNPACKEDVAR* pVar = vars.GetFirst(); pVar != NULL; pVar = vars.GetNext())
+			names.push_back(pVar->name);
+		return names;
+	}
+
+	// Slot vars, vars kept by name, and "v<ID>" vars that must stay in the name map.
+	void SetMixedVars(CDbPackedVars& vars){
+		vars.SetVar("Name", "Beethro");
+		vars.SetVar("Zed", int(-4));
+		vars.SetVar("a", true);
+		vars.SetVar("v1", int(-1));
+		vars.SetVar("v10", Text("ten").c_str());
+		vars.SetVar("v2", UINT(2));
+		vars.SetVar("v5", "five");
+		vars.SetVar("v70000", int(70000));
+		vars.SetVar("v9", int(9));
+	}
+
+	void RequireMixedVars(const CDbPackedVars& vars){
+		REQUIRE(!strcmp(vars.GetVar("Name", (const char*)NULL), "Beethro"));
+		REQUIRE(vars.GetVar("Zed", int(0)) == -4);
+		REQUIRE(vars.GetVar("a", false));
+		REQUIRE(vars.GetVar("v1", int(0)) == -1);
+		REQUIRE(HasText(vars, "v10", "ten"));
+		REQUIRE(vars.GetVar("v2", UINT(0)) == 2);
+		REQUIRE(!strcmp(vars.GetVar("v5", (const char*)NULL), "five"));
+		REQUIRE(vars.GetVar("v70000", int(0)) == 70000);
+		REQUIRE(vars.GetVar("v9", int(0)) == 9);
+
+		REQUIRE(vars.GetVarType("v1") == UVT_int);
+		REQUIRE(vars.GetVarType("v10") == UVT_wchar_string);
+		REQUIRE(vars.GetVarType("v2") == UVT_uint);
+		REQUIRE(vars.GetVarType("v5") == UVT_char_string);
+		REQUIRE(vars.GetHoldVarInt(1) == -1);
+		REQUIRE(vars.GetHoldVarInt(9) == 9);
+		REQUIRE(WSTRING(vars.GetHoldVarText(10)) == Text("ten"));
+		REQUIRE(vars.GetHoldVarType(5) == UVT_char_string);
+	}
+
+	const char* const MIXED_VAR_NAMES[] = {
+		"Name", "Zed", "a", "v1", "v10", "v2", "v5", "v70000", "v9"
+	};
+	const vector<string> MIXED_VAR_NAME_ORDER(MIXED_VAR_NAMES,
+			MIXED_VAR_NAMES + sizeof(MIXED_VAR_NAMES) / sizeof(MIXED_VAR_NAMES[0]));
+}
+
+TEST_CASE("CDbPackedVars", "[containers]") {
+	CDbPackedVars vars;
+
+	SECTION("Hold vars set by name can be read by name and by ID, and unset") {
+		vars.SetVar("v3", int(-5));
+		vars.SetVar("v4", UINT(6));
+		REQUIRE(vars.DoesVarExist("v3"));
+		REQUIRE(vars.GetVar("v3", int(0)) == -5);
+		REQUIRE(vars.GetVarType("v3") == UVT_int);
+		REQUIRE(vars.GetVarValueSize("v3") == sizeof(int));
+		REQUIRE(vars.GetHoldVarInt(3) == -5);
+		REQUIRE(vars.GetVar("v4", UINT(0)) == 6);
+		REQUIRE(vars.GetHoldVarType(4) == UVT_uint);
+
+		vars.SetHoldVar(3, 8);
+		REQUIRE(vars.GetVar("v3", int(0)) == 8);
+
+		vars.Unset("v3");
+		REQUIRE(!vars.DoesVarExist("v3"));
+		REQUIRE(vars.GetVar("v3", int(-1)) == -1);
+		REQUIRE(vars.GetVarType("v3") == UVT_unknown);
+		REQUIRE(vars.GetHoldVarType(3) == UVT_unknown);
+		REQUIRE(vars.GetHoldVarInt(3, 12) == 12);
+		REQUIRE(vars.GetVar("v4", UINT(0)) == 6);
+		REQUIRE(IteratedNames(vars) == vector<string>(1, "v4"));
+	}
+
+	SECTION("Hold vars can change between int and text values") {
+		vars.SetVar("v7", int(3));
+		vars.SetVar("v7", Text("seven").c_str());
+		REQUIRE(vars.GetVarType("v7") == UVT_wchar_string);
+		REQUIRE(HasText(vars, "v7", "seven"));
+		REQUIRE(vars.GetVarValueSize("v7") == 6 * sizeof(WCHAR));
+
+		vars.SetHoldVar(7, 4);
+		REQUIRE(vars.GetVarType("v7") == UVT_int);
+		REQUIRE(vars.GetVar("v7", int(0)) == 4);
+
+		vars.SetHoldVar(7, Text("again").c_str());
+		REQUIRE(WSTRING(vars.GetHoldVarText(7)) == Text("again"));
+		REQUIRE(IteratedNames(vars) == vector<string>(1, "v7"));
+	}
+
+	SECTION("Hold vars of other types are kept by name") {
+		vars.SetVar("v6", "text");
+		REQUIRE(vars.GetVarType("v6") == UVT_char_string);
+		REQUIRE(vars.GetHoldVarType(6) == UVT_char_string);
+
+		// Moving into the slot table and back leaves a single var.
+		vars.SetVar("v6", int(6));
+		REQUIRE(vars.GetHoldVarInt(6) == 6);
+		REQUIRE(IteratedNames(vars) == vector<string>(1, "v6"));
+		vars.SetVar("v6", "text");
+		REQUIRE(!strcmp(vars.GetVar("v6", (const char*)NULL), "text"));
+		REQUIRE(IteratedNames(vars) == vector<string>(1, "v6"));
+		REQUIRE(PackedNames(Pack(vars)) == vector<string>(1, "v6"));
+	}
+
+	SECTION("Copies are independent") {
+		SetMixedVars(vars);
+		CDbPackedVars copy(vars);
+		RequireMixedVars(copy);
+
+		CDbPackedVars assigned;
+		assigned.SetVar("v2", int(-2));
+		assigned.SetVar("Other", int(1));
+		assigned = vars;
+		RequireMixedVars(assigned);
+		REQUIRE(!assigned.DoesVarExist("Other"));
+
+		copy.SetVar("v1", int(100));
+		copy.SetHoldVar(10, Text("changed").c_str());
+		copy.Unset("Name");
+		RequireMixedVars(vars);
+		REQUIRE(Pack(assigned) == Pack(vars));
+	}
+
+	SECTION("Packing and unpacking keeps every var") {
+		SetMixedVars(vars);
+		const vector<BYTE> buffer = Pack(vars);
+
+		CDbPackedVars unpacked(&buffer[0]);
+		RequireMixedVars(unpacked);
+		REQUIRE(Pack(unpacked) == buffer);
+	}
+
+	SECTION("Vars are packed in name order") {
+		// Set in reverse order, so neither set order nor var ID decides the packed order.
+		for (UINT wI = MIXED_VAR_NAME_ORDER.size(); wI--; )
+			vars.SetVar(MIXED_VAR_NAME_ORDER[wI].c_str(), int(wI));
+		REQUIRE(PackedNames(Pack(vars)) == MIXED_VAR_NAME_ORDER);
+
+		vars.Clear();
+		SetMixedVars(vars);
+		REQUIRE(PackedNames(Pack(vars)) == MIXED_VAR_NAME_ORDER);
+	}
+}
@@ -0,0 +1,190 @@
+#include "../../catch.hpp"
+#include "../../Benchmark.h"
+#include <BackEndLib/IDSet.h>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+using namespace std;
+
+namespace {
+	typedef set<UINT> ReferenceSet;
+
+	// Sizes on both sides of the inline capacity and the merge threshold.
+	const UINT SET_SIZES[] = {0, 1, 3, 4, 5, 8, 9, 17, 64};
+	const UINT SET_SIZE_COUNT = sizeof(SET_SIZES) / sizeof(SET_SIZES[0]);
+
+	// Deterministic pseudo-random IDs, with some repeats.
+	vector<UINT> ScatteredIDs(UINT seed, const UINT count){
+		vector<UINT> ids;
+		for (UINT i = 0; i < count; ++i){
+			seed = seed * 1103515245 + 12345;
+			ids.push_back((seed >> 8) % (count * 2 + 1));
+		}
+		return ids;
+	}
+
+	void Build(const vector<UINT>& ids, CIDSet& idSet, ReferenceSet& reference){
+		for (vector<UINT>::const_iterator it = ids.begin(); it != ids.end(); ++it){
+			idSet += *it;
+			reference.insert(*it);
+		}
+	}
+
+	void RequireSameMembers(const CIDSet& idSet, const ReferenceSet& reference){
+		REQUIRE(idSet.size() == reference.size());
+		REQUIRE(idSet.empty() == reference.empty());
+		REQUIRE(vector<UINT>(idSet.begin(), idSet.end()) == vector<UINT>(reference.begin(), reference.end()));
+		REQUIRE(vector<UINT>(idSet.rbegin(), idSet.rend()) == vector<UINT>(reference.rbegin(), reference.rend()));
+		REQUIRE(idSet.getFirst() == (reference.empty() ? 0 : *reference.begin()));
+		REQUIRE(idSet.getLast() == (reference.empty() ? 0 : *reference.rbegin()));
+	}
+}
+
+TEST_CASE("CIDSet", "[containers]") {
+	SECTION("Insertion in any order iterates in ascending order") {
+		CIDSet ascending, descending, scattered;
+		ReferenceSet reference, scatteredReference;
+		for (UINT id = 1; id <= 40; ++id){
+			ascending += id;
+			descending += 41 - id;
+			reference.insert(id);
+		}
+		RequireSameMembers(ascending, reference);
+		RequireSameMembers(descending, reference);
+		REQUIRE(ascending == descending);
+
+		Build(ScatteredIDs(1, 200), scattered, scatteredReference);
+		RequireSameMembers(scattered, scatteredReference);
+
+		const vector<UINT> ids = ScatteredIDs(2, 50);
+		CIDSet fromVector(ids);
+		RequireSameMembers(fromVector, ReferenceSet(ids.begin(), ids.end()));
+	}
+
+	SECTION("Has and erase match std::set") {
+		CIDSet idSet;
+		ReferenceSet reference;
+		Build(ScatteredIDs(3, 100), idSet, reference);
+		for (UINT id = 0; id <= 201; ++id)
+			REQUIRE(idSet.has(id) == (reference.count(id) != 0));
+
+		const vector<UINT> removed = ScatteredIDs(4, 100);
+		for (vector<UINT>::const_iterator it = removed.begin(); it != removed.end(); ++it)
+			REQUIRE(idSet.erase(*it) == int(reference.erase(*it)));
+		RequireSameMembers(idSet, reference);
+
+		// Erasing through an iterator returns the next member.
+		while (!idSet.empty()){
+			CIDSet::iterator next = idSet.erase(idSet.begin());
+			reference.erase(reference.begin());
+			REQUIRE(next == idSet.begin());
+			RequireSameMembers(idSet, reference);
+		}
+		REQUIRE(idSet.erase(5) == 0);
+	}
+
+	SECTION("Set algebra matches std::set across storage sizes") {
+		for (UINT i = 0; i < SET_SIZE_COUNT; ++i){
+			for (UINT j = 0; j < SET_SIZE_COUNT; ++j){
+				CIDSet a, b;
+				ReferenceSet refA, refB;
+				Build(ScatteredIDs(5 + i, SET_SIZES[i]), a, refA);
+				Build(ScatteredIDs(50 + j, SET_SIZES[j]), b, refB);
+
+				ReferenceSet expected;
+				set_union(refA.begin(), refA.end(), refB.begin(), refB.end(), inserter(expected, expected.end()));
+				CIDSet unionSet(a);
+				unionSet += b;
+				RequireSameMembers(unionSet, expected);
+
+				expected.clear();
+				set_difference(refA.begin(), refA.end(), refB.begin(), refB.end(), inserter(expected, expected.end()));
+				CIDSet difference(a);
+				difference -= b;
+				RequireSameMembers(difference, expected);
+
+				expected.clear();
+				set_intersection(refA.begin(), refA.end(), refB.begin(), refB.end(), inserter(expected, expected.end()));
+				CIDSet intersection(a);
+				intersection.intersect(b);
+				RequireSameMembers(intersection, expected);
+
+				REQUIRE(a.contains(b) == includes(refA.begin(), refA.end(), refB.begin(), refB.end()));
+				REQUIRE(a.containsAny(b) == !expected.empty());
+				REQUIRE((a == b) == (refA == refB));
+			}
+		}
+	}
+
+	SECTION("Set algebra with itself") {
+		CIDSet idSet;
+		ReferenceSet reference;
+		Build(ScatteredIDs(6, 30), idSet, reference);
+
+		idSet += idSet;
+		RequireSameMembers(idSet, reference);
+		idSet = idSet;
+		RequireSameMembers(idSet, reference);
+		idSet.intersect(idSet);
+		RequireSameMembers(idSet, reference);
+		REQUIRE(idSet.contains(idSet));
+		idSet -= idSet;
+		RequireSameMembers(idSet, ReferenceSet());
+	}
+
+	SECTION("Small sets are stored inline until they outgrow it") {
+		const unsigned long startAllocations = Benchmark::GetAllocationCount();
+		CIDSet idSet;
+		for (UINT id = 4; id >= 1; --id)
+			idSet += id;
+		CIDSet copy(idSet);
+		copy -= 2;
+		copy += 7;
+		REQUIRE(Benchmark::GetAllocationCount() == startAllocations);
+
+		// The fifth ID moves the set to the heap.
+		idSet += 5;
+		REQUIRE(Benchmark::GetAllocationCount() > startAllocations);
+		ReferenceSet reference;
+		for (UINT id = 1; id <= 5; ++id)
+			reference.insert(id);
+		RequireSameMembers(idSet, reference);
+
+		// Growing further keeps every member.
+		for (UINT id = 100; id > 5; --id){
+			idSet += id;
+			reference.insert(id);
+		}
+		RequireSameMembers(idSet, reference);
+
+		// A set that shrinks back to a few IDs keeps working, and its copies are inline again.
+		for (UINT id = 4; id <= 100; ++id){
+			idSet -= id;
+			reference.erase(id);
+		}
+		RequireSameMembers(idSet, reference);
+		const unsigned long shrunkAllocations = Benchmark::GetAllocationCount();
+		CIDSet shrunkCopy(idSet);
+		CIDSet assigned(9);
+		assigned = idSet;
+		REQUIRE(Benchmark::GetAllocationCount() == shrunkAllocations);
+		RequireSameMembers(shrunkCopy, reference);
+		RequireSameMembers(assigned, reference);
+
+		idSet.clear();
+		RequireSameMembers(idSet, ReferenceSet());
+		idSet += 3;
+		reference.clear();
+		reference.insert(3);
+		RequireSameMembers(idSet, reference);
+
+		// Assigning a large set to an inline set moves it to the heap.
+		CIDSet large;
+		ReferenceSet largeReference;
+		Build(ScatteredIDs(7, 40), large, largeReference);
+		copy = large;
+		RequireSameMembers(copy, largeReference);
+	}
+}
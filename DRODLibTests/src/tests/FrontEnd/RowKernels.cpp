@@ -0,0 +1,131 @@
+#include "../../catch.hpp"
+#include "../../../../FrontEndLib/RowKernels.h"
+
+#include <vector>
+using namespace std;
+
+// The SSE2 kernels handle four pixels at a time and leave the rest of a row to
+// the scalar code. Both must give the same bytes, whatever the row width and
+// alignment, so a tile looks the same however its rows are split.
+
+namespace {
+	const Uint8 TRANS_COLOR[3] = {192, 192, 192};
+	const UINT MAX_ROW_PIXELS = 47;
+
+	struct Random {
+		Random(const UINT seed) : state(seed) {}
+		UINT Next(const UINT range){
+			this->state = this->state * 1103515245 + 12345;
+			return (this->state >> 8) % range;
+		}
+		UINT state;
+	};
+
+	vector<Uint8> RandomPixels(Random& random, const UINT pixels){
+		vector<Uint8> bytes(pixels * 4);
+		for (UINT i = 0; i < bytes.size(); ++i)
+			bytes[i] = Uint8(random.Next(256));
+		return bytes;
+	}
+
+	// Roughly a third of the mask pixels are the transparent color key.
+	vector<Uint8> RandomMask(Random& random, const UINT pixels){
+		vector<Uint8> mask = RandomPixels(random, pixels);
+		for (UINT wPixel = 0; wPixel < pixels; ++wPixel)
+			if (!random.Next(3))
+				for (UINT i = 0; i < 3; ++i)
+					mask[wPixel * 4 + PIXEL_FUDGE_FACTOR + i] = TRANS_COLOR[i];
+		return mask;
+	}
+}
+
+TEST_CASE("Row kernels", "[frontend]") {
+	Random random(7);
+
+	SECTION("ScaleRow32 matches the scalar kernel") {
+		const PixelKey32 key(TRANS_COLOR);
+		for (UINT wOffset = 0; wOffset < 4; ++wOffset){
+			for (UINT wPixels = 0; wPixels <= MAX_ROW_PIXELS; ++wPixels){
+				Uint16 factors[4];
+				for (UINT i = 0; i < 4; ++i)
+					factors[i] = Uint16(random.Next(4) ? random.Next(2 * 256) : random.Next(65281));
+
+				const vector<Uint8> source = RandomPixels(random, wOffset + wPixels);
+				const vector<Uint8> mask = RandomMask(random, wOffset + wPixels);
+				for (UINT bMasked = 0; bMasked < 2; ++bMasked){
+					vector<Uint8> fast(source), scalar(source);
+					const Uint8 *pMask = bMasked ? &mask[wOffset * 4] : NULL;
+					CRowKernels::ScaleRow32(&fast[wOffset * 4], pMask, key, wPixels, factors);
+					CRowKernels::ScaleRow32Scalar(&scalar[wOffset * 4], pMask, key, wPixels, factors);
+					REQUIRE(fast == scalar);
+				}
+			}
+		}
+	}
+
+	SECTION("ScaleRow32 skips color-keyed mask pixels") {
+		const PixelKey32 key(TRANS_COLOR);
+		const Uint16 factors[4] = {512, 512, 512, 512};
+		const vector<Uint8> source = RandomPixels(random, MAX_ROW_PIXELS);
+		const vector<Uint8> mask = RandomMask(random, MAX_ROW_PIXELS);
+		vector<Uint8> pixels(source);
+		CRowKernels::ScaleRow32(&pixels[0], &mask[0], key, MAX_ROW_PIXELS, factors);
+		for (UINT wPixel = 0; wPixel < MAX_ROW_PIXELS; ++wPixel){
+			const bool bKeyed = key.IsKeyed(&mask[wPixel * 4]);
+			for (UINT i = 0; i < 4; ++i){
+				const UINT doubled = source[wPixel * 4 + i] * 2;
+				REQUIRE(pixels[wPixel * 4 + i] == (bKeyed ? source[wPixel * 4 + i] : Uint8(doubled < 255 ? doubled : 255)));
+			}
+		}
+	}
+
+	SECTION("Fixed-point scaling is within one step of the float multiply") {
+		// Factors that are multiples of 1/256 give exactly the float result.
+		for (UINT factor = 0; factor <= 3 * 256; factor += 17){
+			const Uint16 factors[4] = {Uint16(factor), Uint16(factor), Uint16(factor), Uint16(factor)};
+			for (UINT value = 0; value < 256; ++value){
+				Uint8 pixel[4] = {Uint8(value), Uint8(value), Uint8(value), Uint8(value)};
+				CRowKernels::ScaleRow32Scalar(pixel, NULL, PixelKey32(), 1, factors);
+				const UINT expected = UINT(value * (factor / 256.0f));
+				REQUIRE(pixel[0] == (expected < 255 ? expected : 255));
+			}
+		}
+
+		for (UINT test = 0; test < 200; ++test){
+			const float fFactor = random.Next(4000) / 1000.0f;
+			const Uint16 factor = CRowKernels::FixedPoint8_8(fFactor);
+			const Uint16 factors[4] = {factor, factor, factor, factor};
+			const UINT value = random.Next(256);
+			Uint8 pixel[4] = {Uint8(value), Uint8(value), Uint8(value), Uint8(value)};
+			CRowKernels::ScaleRow32Scalar(pixel, NULL, PixelKey32(), 1, factors);
+			UINT expected = UINT(value * fFactor);
+			if (expected > 255)
+				expected = 255;
+			REQUIRE(int(pixel[0]) - int(expected) <= 1);
+			REQUIRE(int(expected) - int(pixel[0]) <= 1);
+		}
+	}
+
+	SECTION("ShadeRow32 matches the scalar kernel") {
+		for (UINT wOffset = 0; wOffset < 4; ++wOffset){
+			for (UINT wPixels = 0; wPixels <= MAX_ROW_PIXELS; ++wPixels){
+				Uint8 colorBytes[4], byteMask[4];
+				for (UINT i = 0; i < 4; ++i){
+					colorBytes[i] = Uint8(random.Next(256));
+					byteMask[i] = random.Next(4) ? 0xff : 0;
+				}
+
+				const vector<Uint8> source = RandomPixels(random, wOffset + wPixels);
+				vector<Uint8> fast(source), scalar(source);
+				CRowKernels::ShadeRow32(&fast[wOffset * 4], wPixels, colorBytes, byteMask);
+				CRowKernels::ShadeRow32Scalar(&scalar[wOffset * 4], wPixels, colorBytes, byteMask);
+				REQUIRE(fast == scalar);
+
+				for (UINT wByte = wOffset * 4; wByte < source.size(); ++wByte){
+					const UINT i = wByte % 4;
+					REQUIRE(scalar[wByte] == (byteMask[i] ? Uint8((source[wByte] + colorBytes[i]) / 2) : source[wByte]));
+				}
+			}
+		}
+	}
+}
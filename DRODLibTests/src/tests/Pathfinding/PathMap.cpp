@@ -0,0 +1,95 @@
+#include "../../catch.hpp"
+#include "../../../../DRODLib/Pathmap.h"
+
+#include <vector>
+using namespace std;
+
+// Cached paths must give exactly what a full recalculation gives, as pathmaps
+// decide monster moves and any difference would break recorded demos.
+
+namespace {
+	const UINT COLS = 38, ROWS = 32;
+
+	UINT Random(UINT& seed, const UINT range){
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 16) % range;
+	}
+
+	void RequireMatchesFreshPathMap(CPathMap& pathMap, const vector<UINT>& obstacles,
+		const UINT xTarget, const UINT yTarget, const UINT dwPathThroughObstacleCost,
+		const bool bSupportPartialObstacles)
+	{
+		CPathMap fresh(COLS, ROWS, (UINT)-1, (UINT)-1,
+				dwPathThroughObstacleCost, bSupportPartialObstacles);
+		for (UINT i = 0; i < COLS * ROWS; ++i)
+			fresh.SetSquare(i % COLS, i / COLS, obstacles[i]);
+		fresh.SetTarget(xTarget, yTarget);
+
+		pathMap.CalcPaths();
+		fresh.CalcPaths();
+		for (UINT wY = 0; wY < ROWS; ++wY)
+			for (UINT wX = 0; wX < COLS; ++wX){
+				const SQUARE& square = pathMap.GetSquare(wX, wY);
+				const SQUARE& expected = fresh.GetSquare(wX, wY);
+				REQUIRE(square.eBlockedDirections == expected.eBlockedDirections);
+				REQUIRE(square.dwSteps == expected.dwSteps);
+				REQUIRE(square.dwTargetDist == expected.dwTargetDist);
+			}
+
+		SORTPOINTS entrances, expectedEntrances;
+		pathMap.GetEntrances(entrances);
+		fresh.GetEntrances(expectedEntrances);
+		REQUIRE(entrances.size() == expectedEntrances.size());
+		for (UINT i = 0; i < entrances.size(); ++i){
+			REQUIRE(entrances[i].wX == expectedEntrances[i].wX);
+			REQUIRE(entrances[i].wY == expectedEntrances[i].wY);
+			REQUIRE(entrances[i].dwScore == expectedEntrances[i].dwScore);
+		}
+	}
+
+	void RunRandomChanges(const UINT dwPathThroughObstacleCost, const bool bSupportPartialObstacles){
+		static const UINT masks[] = {DMASK_NONE, DMASK_ALL, DMASK_N | DMASK_E, DMASK_SW};
+		UINT seed = 7;
+		UINT xTarget = 5, yTarget = 5;
+		vector<UINT> obstacles(COLS * ROWS, DMASK_NONE);
+		CPathMap pathMap(COLS, ROWS, xTarget, yTarget,
+				dwPathThroughObstacleCost, bSupportPartialObstacles);
+
+		for (UINT wStep = 0; wStep < 1500; ++wStep){
+			const UINT wAction = Random(seed, 10);
+			if (wAction < 2){
+				// Obstacle change, sometimes setting the same value again.
+				const UINT wX = Random(seed, COLS), wY = Random(seed, ROWS);
+				const UINT mask = masks[Random(seed, 4)];
+				pathMap.SetSquare(wX, wY, mask);
+				obstacles[wY * COLS + wX] = mask;
+			} else if (wAction < 8){
+				// A few targets, so earlier ones come back while still cached.
+				xTarget = Random(seed, 6);
+				yTarget = Random(seed, 3);
+				if (!Random(seed, 20))
+					xTarget = yTarget = (UINT)-1;
+				pathMap.SetTarget(xTarget, yTarget);
+			}
+			if (Random(seed, 3))
+				continue;
+
+			RequireMatchesFreshPathMap(pathMap, obstacles, xTarget, yTarget,
+					dwPathThroughObstacleCost, bSupportPartialObstacles);
+		}
+	}
+}
+
+TEST_CASE("Pathmap matches a fresh recalculation after random changes", "[pathfinding]") {
+	SECTION("Full obstacles only"){
+		RunRandomChanges(0, false);
+	}
+
+	SECTION("Partial obstacles"){
+		RunRandomChanges(0, true);
+	}
+
+	SECTION("Paths through obstacles"){
+		RunRandomChanges(20, true);
+	}
+}
@@ -0,0 +1,269 @@
+#include "../../catch.hpp"
+#include "../../CTestDb.h"
+#include "../../Runner.h"
+#include "../../RoomBuilder.h"
+#include "../../../../DRODLib/CurrentGame.h"
+#include "../../../../DRODLib/GameConstants.h"
+#include "../../../../DRODLib/PathSearch.h"
+#include "../../../../DRODLib/Roach.h"
+
+#include <queue>
+#include <vector>
+using namespace std;
+
+// Monster searches must choose the same destination and path as before the search
+// state was pooled and the distance field added, or recorded demos would break.
+
+namespace {
+	const UINT COLS = 38, ROWS = 32;
+
+	UINT Random(UINT& seed, const UINT range){
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 16) % range;
+	}
+
+	CCoordSet RandomDests(UINT& seed, const UINT wCount){
+		CCoordSet dests;
+		while (UINT(dests.size()) < wCount)
+			dests.insert(Random(seed, COLS), Random(seed, ROWS));
+		return dests;
+	}
+
+	// The linear scan CMonster::getMinDistance performs.
+	int LinearMinDistance(const UINT wX, const UINT wY, const CCoordSet& dests, ROOMCOORD& closestDest){
+		int nMin = 9999;
+		for (CCoordSet::const_iterator dest = dests.begin(); dest != dests.end(); ++dest){
+			const int nSize = nDist(wX, wY, dest->wX, dest->wY);
+			if (nSize < nMin){
+				nMin = nSize;
+				closestDest = *dest;
+			}
+		}
+		return nMin;
+	}
+
+	// Queries every square several times over, so a search with enough dests switches
+	// from scanning them to the distance field part way through.
+	void RequireMatchesLinearScan(CPathSearch& search, const CCoordSet& dests){
+		search.SetDestinations(dests, COLS, ROWS);
+		for (UINT wPass = 0; wPass < 3; ++wPass)
+			for (UINT wY = 0; wY < ROWS; ++wY)
+				for (UINT wX = 0; wX < COLS; ++wX){
+					ROOMCOORD closest, expectedClosest;
+					const int nDistance = search.GetMinDistance(wX, wY, closest);
+					REQUIRE(nDistance == LinearMinDistance(wX, wY, dests, expectedClosest));
+					REQUIRE(closest.wX == expectedClosest.wX);
+					REQUIRE(closest.wY == expectedClosest.wY);
+				}
+	}
+
+	template <typename NODE>
+	void RequirePriorityQueueOrder(UINT& seed){
+		CPathOpenList<NODE> open;
+		for (UINT wRound = 0; wRound < 3; ++wRound){
+			open.clear();
+			priority_queue<NODE> expected;
+			for (UINT wI = 0; wI < 500; ++wI){
+				// Few distinct scores, so most nodes tie.
+				const NODE node(Random(seed, COLS), Random(seed, ROWS), wI, Random(seed, 8));
+				open.push(node);
+				expected.push(node);
+
+				if (!Random(seed, 4)){
+					REQUIRE(open.top().wX == expected.top().wX);
+					REQUIRE(open.top().wY == expected.top().wY);
+					REQUIRE(open.top().wCost == expected.top().wCost);
+					open.pop();
+					expected.pop();
+				}
+			}
+			while (!expected.empty()){
+				REQUIRE(!open.empty());
+				REQUIRE(open.top().wCost == expected.top().wCost);
+				open.pop();
+				expected.pop();
+			}
+			REQUIRE(open.empty());
+		}
+	}
+
+	class PathTester : public CRoach
+	{
+	public:
+		PathTester(CCurrentGame* pGame) : CRoach(pGame) {}
+
+		using CMonster::getMinDistance;
+		using CMonster::goal;
+		using CMonster::pathToDest;
+	};
+
+	struct PathResult {
+		bool bFound;
+		ROOMCOORD goal;
+		vector<ROOMCOORD> path;
+	};
+
+	PathResult FindPath(PathTester& monster, const UINT wX, const UINT wY,
+		const CCoordSet& dests, const bool bAdjIsGood)
+	{
+		PathResult result;
+		result.bFound = monster.FindOptimalPathTo(wX, wY, dests, bAdjIsGood);
+		result.goal = monster.goal;
+		for (UINT wI = 0; wI < monster.pathToDest.GetSize(); ++wI){
+			UINT wPathX, wPathY;
+			monster.pathToDest.GetAt(wI, wPathX, wPathY);
+			result.path.push_back(ROOMCOORD(wPathX, wPathY));
+		}
+		return result;
+	}
+
+	// Searches to the dests with the distance field allowed, then again with a dest
+	// outside the room added, which keeps the search on the linear scan, and requires
+	// both to find the same path and goal.
+	void RequireSamePathAsLinearScan(PathTester& monster, const UINT wX, const UINT wY,
+		const CCoordSet& dests, const bool bAdjIsGood)
+	{
+		CCoordSet linearDests(dests);
+		linearDests.insert(CCoordSet::BITMAP_COLS - 1, CCoordSet::BITMAP_ROWS - 1);
+
+		const PathResult result = FindPath(monster, wX, wY, dests, bAdjIsGood);
+		const PathResult expected = FindPath(monster, wX, wY, linearDests, bAdjIsGood);
+		REQUIRE(result.bFound == expected.bFound);
+		if (!result.bFound)
+			return;
+		REQUIRE(result.goal.wX == expected.goal.wX);
+		REQUIRE(result.goal.wY == expected.goal.wY);
+		REQUIRE(result.path.size() == expected.path.size());
+		for (UINT wI = 0; wI < result.path.size(); ++wI){
+			REQUIRE(result.path[wI].wX == expected.path[wI].wX);
+			REQUIRE(result.path[wI].wY == expected.path[wI].wY);
+		}
+
+		// The goal is the scanned closest dest from where the path ends.
+		const ROOMCOORD end = result.path.empty() ? ROOMCOORD(wX, wY) : result.path.front();
+		ROOMCOORD closest;
+		REQUIRE(monster.getMinDistance(end.wX, end.wY, dests, closest) <= (bAdjIsGood ? 1 : 0));
+		REQUIRE(result.goal.wX == closest.wX);
+		REQUIRE(result.goal.wY == closest.wY);
+	}
+}
+
+TEST_CASE("Path search distances match a linear scan of the destinations", "[pathfinding]") {
+	CPathSearch search;
+	UINT seed = 11;
+
+	SECTION("Random destinations"){
+		static const UINT counts[] = {1, 2, 3, 9, 40, 300};
+		for (UINT wI = 0; wI < sizeof(counts) / sizeof(counts[0]); ++wI)
+			RequireMatchesLinearScan(search, RandomDests(seed, counts[wI]));
+	}
+
+	SECTION("Tied destinations"){
+		// Squares between the two dests are equally close to both.
+		CCoordSet dests;
+		dests.insert(10, 5);
+		dests.insert(20, 5);
+		RequireMatchesLinearScan(search, dests);
+
+		// Enough dests for the distance field to be used.
+		for (UINT wX = 0; wX < COLS; wX += 2)
+			dests.insert(wX, 20);
+		RequireMatchesLinearScan(search, dests);
+	}
+}
+
+TEST_CASE("Path open lists pop nodes in priority_queue order", "[pathfinding]") {
+	UINT seed = 5;
+
+	SECTION("Original node ordering"){
+		RequirePriorityQueueOrder<CPathNode>(seed);
+	}
+
+	SECTION("Fixed node ordering"){
+		RequirePriorityQueueOrder<CPathNode2>(seed);
+	}
+}
+
+TEST_CASE("Path search context leases", "[pathfinding]") {
+	CPathSearchContext context;
+
+	SECTION("Nested searches get their own state"){
+		CPathSearchLease outer(context);
+		CCoordSet outerDests;
+		outerDests.insert(1, 1);
+		outer->SetDestinations(outerDests, COLS, ROWS);
+		{
+			CPathSearchLease inner(context);
+			REQUIRE(&*inner != &*outer);
+
+			CCoordSet innerDests;
+			innerDests.insert(30, 30);
+			inner->SetDestinations(innerDests, COLS, ROWS);
+		}
+
+		ROOMCOORD closest;
+		REQUIRE(outer->GetMinDistance(5, 5, closest) == 4);
+		REQUIRE(closest.wX == 1);
+		REQUIRE(closest.wY == 1);
+	}
+
+	SECTION("Released searches are reused"){
+		CPathSearch* pSearch;
+		{
+			CPathSearchLease lease(context);
+			pSearch = &*lease;
+		}
+		CPathSearchLease lease(context);
+		REQUIRE(&*lease == pSearch);
+	}
+
+	SECTION("Copies don't share searches"){
+		CPathSearchLease lease(context);
+		CPathSearchContext copy(context);
+		CPathSearchLease copyLease(copy);
+		REQUIRE(&*copyLease != &*lease);
+	}
+}
+
+TEST_CASE("Monster paths to many destinations match a linear scan", "[pathfinding][game]") {
+	RoomBuilder::ClearRoom();
+
+	// Walls the searches must route around.
+	RoomBuilder::PlotRect(T_WALL, 8, 4, 8, 27);
+	RoomBuilder::PlotRect(T_WALL, 16, 0, 16, 20);
+	RoomBuilder::PlotRect(T_WALL, 24, 10, 24, 31);
+	RoomBuilder::PlotRect(T_WALL, 9, 24, 20, 24);
+
+	// An enclosure no search can get near.
+	RoomBuilder::PlotRect(T_WALL, 28, 0, 28, 8);
+	RoomBuilder::PlotRect(T_WALL, 29, 8, 37, 8);
+
+	CCurrentGame* pGame = Runner::StartGame(1, 1, S);
+	PathTester monster(pGame);
+	UINT seed = 3;
+
+	SECTION("Random destinations on both sides of the distance field threshold"){
+		static const UINT counts[] = {1, 2, 5, 12, 40, 200};
+		for (UINT wI = 0; wI < sizeof(counts) / sizeof(counts[0]); ++wI)
+			for (UINT wStart = 0; wStart < 6; ++wStart){
+				const CCoordSet dests = RandomDests(seed, counts[wI]);
+				const UINT wX = Random(seed, COLS), wY = Random(seed, ROWS);
+				RequireSamePathAsLinearScan(monster, wX, wY, dests, true);
+				RequireSamePathAsLinearScan(monster, wX, wY, dests, false);
+			}
+	}
+
+	SECTION("Tied destinations"){
+		// (29,15) is one step from both dests.
+		CCoordSet dests;
+		dests.insert(30, 14);
+		dests.insert(30, 16);
+		RequireSamePathAsLinearScan(monster, 4, 15, dests, true);
+
+		// Enough unreachable dests for the distance field to be used.
+		for (UINT wY = 0; wY <= 6; ++wY)
+			for (UINT wX = 30; wX < COLS; ++wX)
+				dests.insert(wX, wY);
+		RequireSamePathAsLinearScan(monster, 4, 15, dests, true);
+	}
+}
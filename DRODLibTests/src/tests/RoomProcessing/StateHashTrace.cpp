@@ -0,0 +1,66 @@
+#include "../../catch.hpp"
+#include "../../CTestDb.h"
+#include "../../Runner.h"
+#include "../../RoomBuilder.h"
+#include "../../../../DRODLib/CurrentGame.h"
+#include "../../../../DRODLib/DbCommands.h"
+
+#include <vector>
+using namespace std;
+
+namespace {
+	const UINT PLAYED_TURNS = 60;
+
+	// Replays the recorded commands in a freshly started game and returns the state hash trace.
+	vector<ULONGLONG> ReplayCommands(const CDbCommands& commands){
+		CCurrentGame* pGame = Runner::StartGame(2, 2, S);
+		pGame->Commands = commands;
+
+		CCueEvents CueEvents;
+		vector<ULONGLONG> trace;
+		REQUIRE(pGame->PlayAllCommands(CueEvents, false, &trace));
+		REQUIRE(pGame->wTurnNo == PLAYED_TURNS);
+		return trace;
+	}
+}
+
+TEST_CASE("State hash trace of a replay", "[game]") {
+	RoomBuilder::ClearRoom();
+
+	// Player walks around a walled-off cell, while roaches led by a brain move outside it.
+	RoomBuilder::PlotRect(T_WALL, 0, 0, 4, 4);
+	RoomBuilder::PlotRect(T_FLOOR, 1, 1, 3, 3);
+	for (UINT wY = 8; wY <= 20; wY += 4)
+		for (UINT wX = 8; wX <= 32; wX += 4)
+			RoomBuilder::AddMonster(M_ROACH, wX, wY);
+	RoomBuilder::AddMonster(M_BRAIN, 20, 28);
+
+	static const UINT moves[] = {CMD_E, CMD_S, CMD_C, CMD_W, CMD_N, CMD_CC};
+	static const UINT wNumMoves = sizeof(moves) / sizeof(moves[0]);
+
+	CCurrentGame* pGame = Runner::StartGame(2, 2, S);
+	vector<ULONGLONG> playedTrace;
+	for (UINT i = 0; i < PLAYED_TURNS; ++i){
+		Runner::ExecuteCommand(moves[i % wNumMoves]);
+		playedTrace.push_back(pGame->GetStateHash());
+	}
+	REQUIRE(pGame->Commands.Count() == PLAYED_TURNS);
+	const CDbCommands commands(pGame->Commands);
+
+	SECTION("Trace has one hash per command, matching the hashes seen in play"){
+		const vector<ULONGLONG> trace = ReplayCommands(commands);
+		REQUIRE(trace.size() == PLAYED_TURNS);
+		REQUIRE(trace == playedTrace);
+	}
+
+	SECTION("Replaying twice gives identical traces"){
+		const vector<ULONGLONG> first = ReplayCommands(commands);
+		const vector<ULONGLONG> second = ReplayCommands(commands);
+		REQUIRE(first == second);
+	}
+
+	SECTION("Hash changes as the room state changes"){
+		for (UINT i = 1; i < PLAYED_TURNS; ++i)
+			REQUIRE(playedTrace[i] != playedTrace[i - 1]);
+	}
+}
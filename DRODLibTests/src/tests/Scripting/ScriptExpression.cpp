@@ -0,0 +1,123 @@
+#include "../../test-include.hpp"
+#include "../../../../DRODLib/DbHolds.h"
+#include "../../../../DRODLib/PlayerStats.h"
+#include "../../../../DRODLib/ScriptExpression.h"
+
+// Compiled expressions stand in for CCharacter::parseExpression, so they must give
+// exactly the value it does for every expression it accepts.
+
+namespace {
+	WSTRING Expression(const char* pszText){
+		WSTRING wstr;
+		AsciiToUnicode(pszText, wstr);
+		return wstr;
+	}
+
+	WSTRING VarName(const ScriptVars::Predefined eVar){
+		return ScriptVars::getVarNameW(eVar);
+	}
+
+	int Interpret(const WSTRING& wstrExpression, CCurrentGame* pGame, CCharacter* pNPC){
+		UINT index = 0;
+		return CCharacter::parseExpression(wstrExpression.c_str(), index, pGame, pNPC);
+	}
+
+	void RequireSameValue(const WSTRING& wstrExpression, CCurrentGame* pGame, CCharacter* pNPC){
+		const int expected = Interpret(wstrExpression, pGame, pNPC);
+
+		CScriptExpression expression;
+		REQUIRE(expression.Compile(wstrExpression.c_str(), pGame->pHold));
+		REQUIRE(expression.Evaluate(pGame, pNPC) == expected);
+		REQUIRE(CCharacter::evalExpression(wstrExpression, pGame, pNPC) == expected);
+	}
+
+	void RequireSameValues(const char* const* expressions, const UINT wCount,
+		CCurrentGame* pGame, CCharacter* pNPC)
+	{
+		for (UINT wI = 0; wI < wCount; ++wI)
+			RequireSameValue(Expression(expressions[wI]), pGame, pNPC);
+		REQUIRE(Runner::GetNewAssertsCount() == 0);
+	}
+}
+
+TEST_CASE("Compiled script expressions match parsed evaluation", "[game]") {
+	RoomBuilder::ClearRoom();
+
+	CCurrentGame* pGame = Runner::StartGame(3, 4, N);
+	CCharacter npc(pGame);
+	npc.wX = 10;
+	npc.wY = 12;
+	CCharacter* pNPC = &npc;
+
+	SECTION("Operators"){
+		static const char* const expressions[] = {
+			"1+2*3", "(1+2)*3", "10-4-3", "2*3%4", "20/3*3", "100/10/5", "7 % 3 * 2",
+			"-5+2", "-(5+2)*3", "- 2*3", "+7", "-7%3", "-7/2", "((((1))))",
+			"  ( 4 )  ", "7/0", "7%0", "7/(2-2)", "0/0", "5%(3-3)+1", "3*0/0%0"
+		};
+		RequireSameValues(expressions, sizeof(expressions) / sizeof(expressions[0]), pGame, NULL);
+	}
+
+	SECTION("Hold vars"){
+		CDbHold& hold = *pGame->pHold;
+		hold.AddVar(Expression("Score").c_str());
+		hold.AddVar(Expression("Zero").c_str());
+		hold.AddVar(Expression("Total Score").c_str());
+		hold.AddVar(Expression("Text").c_str());
+		pGame->stats.SetVar(hold.getVarAccessToken("Zero"), int(0));
+		pGame->stats.SetVar(hold.getVarAccessToken("Total Score"), int(-40));
+		pGame->stats.SetVar(hold.getVarAccessToken("Text"), Expression("12").c_str());
+
+		static const char* const expressions[] = {
+			"Score*2+1", "Score/Zero", "Score%Zero", "-Score", "Total Score/Score",
+			"Total Score  * 2", "(Total Score)%Score", "Text+1", "Unknown+1", "Unknown*Score"
+		};
+		static const int values[] = {7, -3, 0};
+		for (UINT wI = 0; wI < sizeof(values) / sizeof(values[0]); ++wI){
+			// Cached compiled forms must see the new value.
+			pGame->stats.SetVar(hold.getVarAccessToken("Score"), values[wI]);
+			RequireSameValues(expressions, sizeof(expressions) / sizeof(expressions[0]), pGame, NULL);
+		}
+	}
+
+	SECTION("Built-in and local vars"){
+		npc.SetLocalVar(Expression(".count"), Expression("6"));
+		npc.SetLocalVar(Expression(".name"), Expression("Beethro"));
+
+		const WSTRING wstrPlayerX = VarName(ScriptVars::P_PLAYER_X);
+		const WSTRING wstrPlayerY = VarName(ScriptVars::P_PLAYER_Y);
+		const WSTRING wstrMonsterX = VarName(ScriptVars::P_MONSTER_X);
+		const WSTRING wstrLevelName = VarName(ScriptVars::P_LEVELNAME);
+		const WSTRING expressions[] = {
+			wstrPlayerX + Expression("*100+") + wstrPlayerY,
+			wstrMonsterX + Expression("-") + wstrPlayerX,
+			wstrLevelName + Expression("+1"),
+			Expression(".count*2-1"),
+			Expression(".name+1"),
+			Expression(".missing+1"),
+			Expression(".count%") + wstrPlayerX
+		};
+		for (UINT wI = 0; wI < sizeof(expressions) / sizeof(expressions[0]); ++wI){
+			RequireSameValue(expressions[wI], pGame, NULL);
+			RequireSameValue(expressions[wI], pGame, pNPC);
+		}
+		REQUIRE(Runner::GetNewAssertsCount() == 0);
+	}
+
+	SECTION("Malformed expressions aren't compiled and still report parse errors"){
+		static const char* const expressions[] = {
+			"1+", "(1+2", "2 3", "3a+1", "1+*2", "", "#", "1)", "4*(2+)", "-"
+		};
+		for (UINT wI = 0; wI < sizeof(expressions) / sizeof(expressions[0]); ++wI){
+			const WSTRING wstrExpression = Expression(expressions[wI]);
+
+			CScriptExpression expression;
+			REQUIRE(!expression.Compile(wstrExpression.c_str(), pGame->pHold));
+
+			const UINT wErrorCount = Runner::GetNewAssertsCount();
+			REQUIRE(CCharacter::evalExpression(wstrExpression, pGame, pNPC) ==
+					Interpret(wstrExpression, pGame, pNPC));
+			REQUIRE(Runner::GetNewAssertsCount() > wErrorCount);
+		}
+	}
+}
@@ -109,6 +109,9 @@ void     PrintTestHelp();
 void     PrintUnprotect(const COptionList &Options, const WCHAR *pszFilePath);
 void     PrintUnprotectHelp();
 void     PrintUsage();
+bool     PrintVerifyAll(const COptionList &Options, const WCHAR *pszSrcPath,
+		const WCHAR *pszSrcVersion);
+void     PrintVerifyAllHelp();
 
 //Constants
 static const WCHAR wszCreate[] = {{'c'},{'r'},{'e'},{'a'},{'t'},{'e'},{0}};
@@ -127,6 +130,7 @@ static const WCHAR *wszProtect = wszUnprotect + 2;
 static const WCHAR wszMySQL[] = {{'m'},{'y'},{'s'},{'q'},{'l'},{0}};
 static const WCHAR wszUncompress[] = {{'u'},{'n'},{'c'},{'o'},{'m'},{'p'},{'r'},{'e'},{'s'},{'s'},{0}};
 static const WCHAR *wszCompress = wszUncompress + 2;
+static const WCHAR wszVerifyAll[] = {{'v'},{'e'},{'r'},{'i'},{'f'},{'y'},{'-'},{'a'},{'l'},{'l'},{0}};
 
 static const WCHAR wszDefault[] = {{'d'},{'e'},{'f'},{'a'},{'u'},{'l'},{'t'},{0}};
 
@@ -189,6 +193,7 @@ int wmain(int argc, WCHAR* argv[])
 		argv[((n) + OptionList.GetSize())] : NULL)
 
 	//Parse command and call appropriate function.
+	bool bSuccess = true;
 	if     (WCSicmp(argv[1], wszCreate) == 0)    PrintCreate(OptionList, OPT_PARAM(2), OPT_PARAM(3));
 	else if(WCSicmp(argv[1], wszDelete) == 0)    PrintDelete(OptionList, OPT_PARAM(2), OPT_PARAM(3));
 	else if(WCSicmp(argv[1], wszDemo) == 0)         PrintDemo(OptionList, OPT_PARAM(2), OPT_PARAM(3), OPT_PARAM(4));
@@ -205,12 +210,13 @@ int wmain(int argc, WCHAR* argv[])
 	else if(WCSicmp(argv[1], wszMySQL) == 0)     PrintMysql(OptionList, OPT_PARAM(2), OPT_PARAM(3), OPT_PARAM(4));
 	else if(WCSicmp(argv[1], wszCompress) == 0)     PrintCompress(OptionList, OPT_PARAM(2), OPT_PARAM(3));
 	else if(WCSicmp(argv[1], wszUncompress) == 0)   PrintUncompress(OptionList, OPT_PARAM(2), OPT_PARAM(3));
+	else if(WCSicmp(argv[1], wszVerifyAll) == 0) bSuccess = PrintVerifyAll(OptionList, OPT_PARAM(2), OPT_PARAM(3));
 	else                                PrintUsage();
 
 #undef OPT_PARAM
 
 	DEBUGPAUSE;
-	return 0;
+	return bSuccess ? 0 : 4;
 }
 
 //******************************************************************************************
@@ -290,6 +296,7 @@ void PrintUsage()
 			"  test      [ Options ] [ [ [ DemoID ] SrcVersion ] SrcPath ]" NEWLINE
 			"  protect   SrcFilePath" NEWLINE
 			"  unprotect SrcFilePath" NEWLINE
+			"  verify-all [ Options ] [ [ SrcPath ] SrcVersion ]" NEWLINE
 			"  compress  SrcFilePath DestFilePath" NEWLINE
 			"  uncompress SrcFilePath DestFilePath" NEWLINE
 			"" NEWLINE
@@ -346,6 +353,7 @@ void PrintHelp(
 	else if (WCSicmp(pszCommand, wszSummary) == 0)     PrintSummaryHelp();
 	else if (WCSicmp(pszCommand, wszProtect) == 0)     PrintProtectHelp();
 	else if (WCSicmp(pszCommand, wszUnprotect) == 0)   PrintUnprotectHelp();
+	else if (WCSicmp(pszCommand, wszVerifyAll) == 0)   PrintVerifyAllHelp();
 	else
 		PrintHelpHelp();
 }
@@ -915,6 +923,73 @@ void PrintTest(
 	}
 }
 
+//******************************************************************************************
+void PrintVerifyAllHelp()
+{
+	PrintHeader();
+	printf(
+	  "verify-all  [-w:count] [-i:index] [ [ SrcPath ] SrcVersion ]" NEWLINE
+	  "" NEWLINE
+	  "Replays every demo and prints a tab-delimited report with one line per demo:" NEWLINE
+	  "ID, result, conquered, died, checksum, recorded checksum, turns and time in" NEWLINE
+	  "milliseconds.  A final TOTAL line gives demos tested, failures and total time." NEWLINE
+	  "A demo fails if it doesn't replay to its recorded checksum, or if its room" NEWLINE
+	  "conquest or death doesn't match what was recorded.  Exit code is 4 if any" NEWLINE
+	  "demo failed." NEWLINE
+	  "" NEWLINE
+	  "Options:" NEWLINE
+	  "  -w:count      Demos are split among this many workers.  Run one process per" NEWLINE
+	  "                worker to replay demos in parallel.  Default is 1." NEWLINE
+	  "  -i:index      Which worker this process is, from 0 to count-1.  Default is 0." NEWLINE
+	  "" NEWLINE
+	  "Params:" NEWLINE
+	  "  SrcPath       Location of data.  If omitted, default path will be used." NEWLINE
+	  "                To verify an exported hold, import it here first." NEWLINE
+	  "  SrcVersion    Version of data.  If omitted, default version will be used." NEWLINE);
+}
+
+//******************************************************************************************
+bool PrintVerifyAll(
+//Replays all demos and reports results.  See PrintVerifyAllHelp for more info.
+//
+//Params:
+	const COptionList &Options,   //(in)
+	const WCHAR *pszSrcPath,      //(in)
+	const WCHAR *pszSrcVersion)   //(in)
+//
+//Returns:
+//True if all demos passed, false if not.
+{
+	PrintHeader();
+
+	static WCHAR options[] = {{'w'},{','},{'i'},{0}};
+	if (!Options.AreOptionsValid(options)) return false;
+
+	WSTRING strSrcPath =
+			(pszSrcPath == NULL || WCSicmp(pszSrcPath, wszDefault)==0 ) ?
+			GetDefaultPath() : pszSrcPath;
+	VERSION eSrcVersion =
+			(pszSrcVersion == NULL || WCSicmp(pszSrcVersion, wszDefault)==0 ) ?
+			GetDefaultVersion() : GetVersionFromParam(pszSrcVersion);
+
+	//Get util for source version.
+	CUtil *pUtil = GetUtil(eSrcVersion, strSrcPath.c_str());
+	if (!pUtil)
+	{
+		printf("FAILED--Version not supported." NEWLINE);
+		return false;
+	}
+
+	//Replay the demos.
+	if (!pUtil->PrintVerifyAll(Options))
+	{
+		printf("FAILED--Not all demos verified." NEWLINE);
+		return false;
+	}
+	printf("SUCCESS--All demos verified." NEWLINE);
+	return true;
+}
+
 //******************************************************************************************
 void PrintDemoHelp()
 {
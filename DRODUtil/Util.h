@@ -77,6 +77,7 @@ public:
 	virtual bool   PrintRoom(const COptionList &/*Options*/, UINT /*dwRoomID*/) const {PrintNotImplemented(); return false;}
 	virtual bool   PrintSummary(const COptionList &/*Options*/) const {PrintNotImplemented(); return false;}
 	virtual bool   PrintTest(const COptionList &/*Options*/, UINT /*dwDemoID*/) const {PrintNotImplemented(); return false;}
+	virtual bool   PrintVerifyAll(const COptionList &/*Options*/) const {PrintNotImplemented(); return false;}
 
 protected:
 	WSTRING        strPath;
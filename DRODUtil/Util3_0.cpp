@@ -45,6 +45,7 @@
 #include <BackEndLib/GameStream.h>
 #include <BackEndLib/Wchar.h>
 #include <BackEndLib/Ports.h>
+#include <BackEndLib/SysTimer.h>
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
 #include <unistd.h> //unlink
@@ -477,6 +478,91 @@ bool CUtil3_0::PrintTest(const COptionList &Options, UINT dwDemoID) const
 	return bRes;
 }
 
+//**************************************************************************************
+bool CUtil3_0::PrintVerifyAll(const COptionList &Options) const
+//Replays every demo and prints one tab-delimited report line per demo.
+//
+//A demo passes when it replays to its recorded checksum and its replayed
+//conquer/death outcome matches the Victory/Death flags stored with it.
+//Options -w:count and -i:index select the share of demos this process
+//replays, so a library can be split across several concurrent processes.
+//
+//Returns: whether every demo replayed passed
+{
+	CDb db;
+	if (!db.IsOpen())
+	{
+		if (db.Open(this->strPath.c_str()) != MID_Success) return false;
+	}
+
+	static const WCHAR wW[] = {{'w'},{0}};
+	static const WCHAR wI[] = {{'i'},{0}};
+	OPTIONNODE *pOpNode = Options.Get(wW);
+	const UINT wWorkers = pOpNode && _Wtoi(pOpNode->szAttributes) > 0 ?
+			_Wtoi(pOpNode->szAttributes) : 1;
+	pOpNode = Options.Get(wI);
+	const UINT wWorker = pOpNode ? _Wtoi(pOpNode->szAttributes) : 0;
+	if (wWorker >= wWorkers)
+	{
+		printf("FAILED--Worker index must be less than worker count." NEWLINE);
+		return false;
+	}
+
+	//Demos are dealt out in ID order, so each worker gets the same share on every run.
+	const CIDSet demoIDs = db.Demos.GetIDs();
+
+	printf("DemoID\tResult\tConquered\tDied\tChecksum\tExpectedChecksum\tTurns\tMs" NEWLINE);
+
+	CIDList DemoStats;
+	UINT wIndex = 0, wTested = 0, wFailed = 0;
+	const UINT dwStartTime = GetTicks();
+	for (CIDSet::const_iterator id = demoIDs.begin(); id != demoIDs.end(); ++id, ++wIndex)
+	{
+		if (wIndex % wWorkers != wWorker)
+			continue;
+		++wTested;
+
+		CDbDemo *pDemo = db.Demos.GetByID(*id);
+		if (!pDemo)
+		{
+			printf("%u\tMISSING\t\t\t\t\t\t" NEWLINE, *id);
+			++wFailed;
+			continue;
+		}
+
+		const UINT dwDemoStart = GetTicks();
+		DemoStats.Clear();
+		const bool bReplayed = pDemo->Test(DemoStats);
+		const UINT dwDemoTime = GetTicks() - dwDemoStart;
+
+		//Outcomes are classified as in CDbSavedGames::VerifyForRoom.
+		const bool bConquered = GetDemoStatBool(DemoStats, DS_WasRoomConquered);
+		const bool bDied = GetDemoStatBool(DemoStats, DS_DidPlayerDie) ||
+				GetDemoStatBool(DemoStats, DS_DidHalphDie);
+		const char *pszResult = NULL;
+		if (!bReplayed)
+			pszResult = "FAIL_REPLAY";
+		else if (bConquered != pDemo->IsFlagSet(CDbDemo::Victory))
+			pszResult = "FAIL_CONQUER";
+		else if (bDied != pDemo->IsFlagSet(CDbDemo::Death))
+			pszResult = "FAIL_DEATH";
+		if (pszResult)
+			++wFailed;
+		else
+			pszResult = "PASS";
+
+		printf("%u\t%s\t%d\t%d\t%u\t%u\t%u\t%u" NEWLINE, *id, pszResult,
+				int(bConquered), int(bDied),
+				GetDemoStatUint(DemoStats, DS_FinalChecksum), pDemo->dwChecksum,
+				GetDemoStatUint(DemoStats, DS_ProcessedTurnCount), dwDemoTime);
+		fflush(stdout);
+		delete pDemo;
+	}
+
+	printf("TOTAL\t%u\t%u\t%u" NEWLINE, wTested, wFailed, GetTicks() - dwStartTime);
+	return wFailed == 0;
+}
+
 //
 //Private methods.
 //
@@ -55,6 +55,7 @@ public:
 	virtual bool  PrintRoom(const COptionList &Options, UINT dwRoomID) const;
 	virtual bool  PrintLevel(const COptionList &Options, UINT dwLevelID) const;
 	virtual bool  PrintTest(const COptionList &Options, UINT dwDemoID) const;
+	virtual bool  PrintVerifyAll(const COptionList &Options) const;
 
 private:
 	static void AddMessageText(c4_Storage &TextStorage, const UINT dwMessageID,
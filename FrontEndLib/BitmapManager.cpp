@@ -36,8 +36,10 @@
 
 #include "Screen.h"
 
+#include "ImageDecoder.h"
 #include "JpegHandler.h"
 #include "PNGHandler.h"
+#include "RowKernels.h"
 
 #include <BackEndLib/Assert.h>
 #include <BackEndLib/Exception.h>
@@ -68,6 +70,9 @@ Uint8 CBitmapManager::TransColor[3] = {192,192,192};	//(r,g,b) color that signif
 static const WCHAR wcszBitmaps[] = { We(SLASH),We('B'),We('i'),We('t'),We('m'),We('a'),We('p'),We('s'),We(SLASH),We(0) };
 static const WCHAR wszTIM[] = { We('.'),We('t'),We('i'),We('m'),We(0) };
 
+//Images decoded at once by LoadImageSurfaces are split among up to this many threads.
+const UINT MAX_IMAGE_DECODE_THREADS = 8;
+
 const UINT wNumImageFormats = 3;
 const WCHAR imageExtension[wNumImageFormats][5] = {
 	{ We('.'),We('p'),We('n'),We('g'),We(0) },   //.png
@@ -1988,6 +1993,22 @@ void CBitmapManager::DarkenRect(
 	Uint8 *pSeek = (Uint8 *)pDestSurface->pixels + wPixelByteNo + PIXEL_FUDGE_FACTOR;
 	Uint8 *const pStop = pSeek + (h * pDestSurface->pitch);
 
+#ifdef ROWKERNELS_SSE2
+	if (wBPP == 4)
+	{
+		Uint16 factors[4] = {256, 256, 256, 256};
+		for (UINT i=0; i<3; ++i)
+			factors[PIXEL_FUDGE_FACTOR + i] = CRowKernels::FixedPoint8_8(fLightPercent);
+
+		Uint8 *pRow = (Uint8 *)pDestSurface->pixels + wPixelByteNo;
+		for (UINT wRow = 0; wRow < h; ++wRow, pRow += pDestSurface->pitch)
+			CRowKernels::ScaleRow32(pRow, NULL, PixelKey32(), w, factors);
+
+		if (SDL_MUSTLOCK(pDestSurface)) SDL_UnlockSurface(pDestSurface);
+		return;
+	}
+#endif
+
 	if (fLightPercent == 0.0f)
 	{
 		//Optimized 0%.
@@ -2090,6 +2111,28 @@ void CBitmapManager::DarkenTileWithMask(
 	Uint8 *const pStop = pSeek + (h * pDestSurface->pitch);
 	Uint8 *pMask = GetTileSurfacePixel(wTIMask, wXOffset, wYOffset) + PIXEL_FUDGE_FACTOR;
 
+#ifdef ROWKERNELS_SSE2
+	if (wBPP == 4 && wMaskBPP == 4)
+	{
+		Uint16 factors[4] = {256, 256, 256, 256};
+		for (UINT i=0; i<3; ++i)
+			factors[PIXEL_FUDGE_FACTOR + i] = CRowKernels::FixedPoint8_8(fLightPercent);
+		const PixelKey32 key(TransColor);
+
+		Uint8 *pRow = (Uint8 *)pDestSurface->pixels + wPixelByteNo;
+		const Uint8 *pMaskRow = pMask - PIXEL_FUDGE_FACTOR;
+		for (UINT wRow = 0; wRow < h; ++wRow)
+		{
+			CRowKernels::ScaleRow32(pRow, pMaskRow, key, w, factors);
+			pRow += pDestSurface->pitch;
+			pMaskRow += pMaskSurface->pitch;
+		}
+
+		if (SDL_MUSTLOCK(pDestSurface)) SDL_UnlockSurface(pDestSurface);
+		return;
+	}
+#endif
+
 	const UINT dark = static_cast<UINT>(fLightPercent / g_DarkenStepIncrement);
 	const Uint8 *const pDarken = g_darkenCalc[dark];
 	while (pSeek != pStop)
@@ -2539,6 +2582,30 @@ void CBitmapManager::LightenRectWithTileMask(
 
 	Uint8 *pSeek = (Uint8 *)pDestSurface->pixels + wPixelByteNo;
 	Uint8 *const pStop = pSeek + (h * pDestSurface->pitch);
+
+#ifdef ROWKERNELS_SSE2
+	if (wBPP == 4 && wMaskBPP == 4)
+	{
+		Uint16 factors[4] = {256, 256, 256, 256};
+		factors[wR] = CRowKernels::FixedPoint8_8(R);
+		factors[wG] = CRowKernels::FixedPoint8_8(G);
+		factors[wB] = CRowKernels::FixedPoint8_8(B);
+		const PixelKey32 key(TransColor);
+
+		const Uint8 *pMaskRow = pMask - PIXEL_FUDGE_FACTOR;
+		for (UINT wRow = 0; wRow < h; ++wRow)
+		{
+			CRowKernels::ScaleRow32(pSeek, pMaskRow, key, w, factors);
+			pSeek += pDestSurface->pitch;
+			pMaskRow += pMaskSurface->pitch;
+		}
+
+		if (SDL_MUSTLOCK(pDestSurface))
+			SDL_UnlockSurface(pDestSurface);
+		return;
+	}
+#endif
+
 	UINT wVal;
 
 	while (pSeek != pStop)
@@ -2611,6 +2678,25 @@ void CBitmapManager::ShadeRect(
 	Uint8 *pSeek = (Uint8 *)pDestSurface->pixels + wPixelByteNo + PIXEL_FUDGE_FACTOR;
 	Uint8 *const pStop = pSeek + (h * pDestSurface->pitch);
 
+#ifdef ROWKERNELS_SSE2
+	if (wBPP == 4)
+	{
+		Uint8 colorBytes[4] = {0, 0, 0, 0}, byteMask[4] = {0, 0, 0, 0};
+		colorBytes[PIXEL_FUDGE_FACTOR] = Color.byt3;  //big endian order
+		colorBytes[PIXEL_FUDGE_FACTOR + 1] = Color.byt2;
+		colorBytes[PIXEL_FUDGE_FACTOR + 2] = Color.byt1;
+		for (UINT i=0; i<3; ++i)
+			byteMask[PIXEL_FUDGE_FACTOR + i] = 0xff;
+
+		Uint8 *pRow = (Uint8 *)pDestSurface->pixels + wPixelByteNo;
+		for (UINT wRow = 0; wRow < h; ++wRow, pRow += pDestSurface->pitch)
+			CRowKernels::ShadeRow32(pRow, w, colorBytes, byteMask);
+
+		if (SDL_MUSTLOCK(pDestSurface)) SDL_UnlockSurface(pDestSurface);
+		return;
+	}
+#endif
+
 	UINT nHue;
 	while (pSeek != pStop)
 	{
@@ -3979,6 +4065,57 @@ SDL_Surface* CBitmapManager::LoadImageSurface(
 	}
 }
 
+//*****************************************************************************
+void CBitmapManager::LoadImageSurfaces(
+//Loads several images from the appropriate location at once, spreading the
+//decoding over as many threads as there are CPU cores.
+//
+//Params:
+	const vector<WSTRING>& names,     //(in)  Relative names of the image files.
+	vector<SDL_Surface*>& surfaces)   //(out) Loaded surface for each name, or NULL
+									  //      where no image file by that name exists.
+{
+	surfaces.assign(names.size(), (SDL_Surface*)NULL);
+
+	//Find the files on this thread.  PNG and JPEG files are queued for decoding.
+	vector<CImageDecoder::Job> jobs;
+	vector<UINT> jobNames;
+	UINT wI;
+	for (wI = 0; wI < names.size(); ++wI)
+	{
+		WSTRING wstrFilepath;
+		const UINT wFormat = GetImageFilepath(names[wI].c_str(), wstrFilepath);
+		if (!wFormat)
+			continue;
+		if (wFormat != DATA_JPG && wFormat != DATA_PNG)
+		{
+			surfaces[wI] = LoadImageSurface(wstrFilepath.c_str(), wFormat);
+			continue;
+		}
+
+		jobs.push_back(CImageDecoder::Job(wstrFilepath, wFormat));
+		jobNames.push_back(wI);
+	}
+
+	CImageDecoder::Decode(jobs, MAX_IMAGE_DECODE_THREADS);
+
+	//Convert the decoded images to the display format here on the main thread.
+	for (wI = 0; wI < jobs.size(); ++wI)
+	{
+		CImageDecoder::Job& job = jobs[wI];
+		if (!job.pSurface)
+		{
+			delete[] job.pImageBuffer;
+			continue;
+		}
+		SDL_Surface *pSurface = ConvertSurface(job.pSurface);
+		if (job.pImageBuffer && pSurface != job.pSurface)
+			delete[] job.pImageBuffer;
+		//else: pImageBuffer shouldn't get deleted, but there will be a memory leak
+		surfaces[jobNames[wI]] = pSurface;
+	}
+}
+
 //*****************************************************************************
 BYTE* CBitmapManager::WriteSurfaceToPixelBuffer(SDL_Surface *pSurface)
 //Convert surface to pixel byte buffer.
@@ -4083,13 +4220,7 @@ SDL_Surface* CBitmapManager::LoadJPEGSurface(
 	UINT wWidth = 0, wHeight = 0;
 	if (!CJpegHandler::Decompress(wszName, pImageBuffer, wWidth, wHeight))
 		return NULL;
-#if GAME_BYTEORDER == GAME_BYTEORDER_BIG
-        SDL_Surface *pTempSurface = SDL_CreateRGBSurfaceFrom(pImageBuffer, wWidth, wHeight,
-                        24, wWidth * 3, 0xff0000, 0xff00, 0xff, 0);  //libjpeg uses BGR format by default
-#else
-	SDL_Surface *pTempSurface = SDL_CreateRGBSurfaceFrom(pImageBuffer, wWidth, wHeight,
-			24, wWidth * 3, 0xff, 0xff00, 0xff0000, 0);  //libjpeg uses BGR format by default
-#endif
+	SDL_Surface *pTempSurface = CImageDecoder::CreateJPEGSurface(pImageBuffer, wWidth, wHeight);
 	SDL_Surface *pSurface = ConvertSurface(pTempSurface);
 	if (pSurface != pTempSurface)
 	{
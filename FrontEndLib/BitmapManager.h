@@ -192,6 +192,7 @@ public:
 
 	virtual SDL_Surface *   LoadImageSurface(const WCHAR *wszName);
 	SDL_Surface * LoadImageSurface(const WCHAR *wszName, const UINT wFormat);
+	void        LoadImageSurfaces(const vector<WSTRING>& names, vector<SDL_Surface*>& surfaces);
 	void        LockTileImagesSurface(const UINT wIndex);
 
 	void        NegativeRect(const UINT x, const UINT y, const UINT w, const UINT h,
@@ -238,6 +238,14 @@ SOURCE=.\HyperLinkWidget.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\ImageDecoder.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\ImageDecoder.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\ImageWidget.cpp
 # End Source File
 # Begin Source File
@@ -526,6 +534,14 @@ SOURCE=.\RotateTileEffect.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\RowKernels.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\RowKernels.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\ScaleTileEffect.cpp
 # End Source File
 # Begin Source File
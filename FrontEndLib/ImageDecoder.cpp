@@ -0,0 +1,136 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 2002, 2005
+ * Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+#include "ImageDecoder.h"
+#include "JpegHandler.h"
+#include "PNGHandler.h"
+
+#include <BackEndLib/Assert.h>
+#include <BackEndLib/Files.h>
+#include <BackEndLib/StretchyBuffer.h>
+
+#include <SDL.h>
+
+struct ImageDecodeQueue
+{
+	ImageDecodeQueue(vector<CImageDecoder::Job>& jobs) : jobs(jobs) {}
+
+	vector<CImageDecoder::Job>& jobs;
+	SDL_atomic_t nextJob;
+};
+
+//*****************************************************************************
+static int SDLCALL DecodeImages(void *pData)
+//Decodes queued images until none are left.
+{
+	ImageDecodeQueue *pQueue = (ImageDecodeQueue*)pData;
+	for (;;)
+	{
+		const UINT wJob = UINT(SDL_AtomicAdd(&pQueue->nextJob, 1));
+		if (wJob >= pQueue->jobs.size())
+			break;
+
+		CImageDecoder::Job& job = pQueue->jobs[wJob];
+		switch (job.wFormat)
+		{
+			case DATA_JPG:
+			{
+				CStretchyBuffer buffer;
+				UINT wWidth = 0, wHeight = 0;
+				if (CFiles::ReadFileIntoBuffer(job.wstrFilepath.c_str(), buffer, true) &&
+						CJpegHandler::Decompress((BYTE*)buffer, buffer.Size(),
+								job.pImageBuffer, wWidth, wHeight))
+					job.pSurface = CImageDecoder::CreateJPEGSurface(job.pImageBuffer, wWidth, wHeight);
+			}
+			break;
+			case DATA_PNG:
+				job.pSurface = CPNGHandler::CreateSurface(job.wstrFilepath.c_str());
+			break;
+			default: ASSERT(!"Unsupported image format in decode queue"); break;
+		}
+	}
+	return 0;
+}
+
+//*****************************************************************************
+SDL_Surface* CImageDecoder::CreateJPEGSurface(BYTE *pImageBuffer, const UINT wWidth, const UINT wHeight)
+//Returns: a surface wrapping decompressed JPEG pixel data
+{
+#if GAME_BYTEORDER == GAME_BYTEORDER_BIG
+	return SDL_CreateRGBSurfaceFrom(pImageBuffer, wWidth, wHeight,
+			24, wWidth * 3, 0xff0000, 0xff00, 0xff, 0);  //libjpeg uses BGR format by default
+#else
+	return SDL_CreateRGBSurfaceFrom(pImageBuffer, wWidth, wHeight,
+			24, wWidth * 3, 0xff, 0xff00, 0xff0000, 0);  //libjpeg uses BGR format by default
+#endif
+}
+
+//*****************************************************************************
+void CImageDecoder::Decode(
+//Decodes the image files, spreading them over as many threads as there are CPU
+//cores, up to a maximum.  The calling thread decodes alongside any workers.
+//
+//Params:
+	vector<Job>& jobs,        //(in/out) files to decode, receiving their surfaces
+	const UINT wMaxThreads)   //(in) at most this many threads are used; 1 decodes serially
+{
+	if (jobs.empty())
+		return;
+
+	ImageDecodeQueue queue(jobs);
+	SDL_AtomicSet(&queue.nextJob, 0);
+
+	UINT wThreads = SDL_GetCPUCount() > 0 ? UINT(SDL_GetCPUCount()) : 1;
+	if (wThreads > wMaxThreads)
+		wThreads = wMaxThreads;
+	if (wThreads > jobs.size())
+		wThreads = jobs.size();
+	vector<SDL_Thread*> workers;
+	for (UINT wI = 1; wI < wThreads; ++wI)
+	{
+		SDL_Thread *pThread = SDL_CreateThread(DecodeImages, "imagedecode", &queue);
+		if (!pThread)
+			break; //remaining jobs are handled by the threads already running
+		workers.push_back(pThread);
+	}
+	DecodeImages(&queue);
+	for (vector<SDL_Thread*>::const_iterator worker = workers.begin();
+			worker != workers.end(); ++worker)
+		SDL_WaitThread(*worker, NULL);
+}
+
+//*****************************************************************************
+void CImageDecoder::Free(Job& job)
+//Frees a decoded image that won't be converted.
+{
+	if (job.pSurface)
+	{
+		SDL_FreeSurface(job.pSurface);
+		job.pSurface = NULL;
+	}
+	delete[] job.pImageBuffer;
+	job.pImageBuffer = NULL;
+}
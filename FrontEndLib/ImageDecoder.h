@@ -0,0 +1,61 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 2002, 2005
+ * Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+//Reads and decompresses PNG and JPEG image files, optionally on several threads.
+//Nothing here touches the display, so decoded surfaces still need converting
+//to the display format, which must be done on the main thread.
+
+#ifndef IMAGEDECODER_H
+#define IMAGEDECODER_H
+
+#include <BackEndLib/Types.h>
+#include <BackEndLib/Wchar.h>
+
+#include <vector>
+using std::vector;
+
+struct SDL_Surface;
+class CImageDecoder
+{
+public:
+	//One image file to decode.
+	struct Job
+	{
+		Job(const WSTRING& wstrFilepath, const UINT wFormat)
+			: wstrFilepath(wstrFilepath), wFormat(wFormat), pSurface(NULL), pImageBuffer(NULL) {}
+
+		WSTRING wstrFilepath;
+		UINT wFormat;           //DATA_PNG or DATA_JPG
+		SDL_Surface *pSurface;  //decoded, or NULL if decoding failed
+		BYTE *pImageBuffer;     //JPEG pixels wrapped by pSurface, owned by the caller
+	};
+
+	static SDL_Surface* CreateJPEGSurface(BYTE *pImageBuffer, const UINT wWidth, const UINT wHeight);
+	static void Decode(vector<Job>& jobs, const UINT wMaxThreads);
+	static void Free(Job& job);
+};
+
+#endif //...#ifndef IMAGEDECODER_H
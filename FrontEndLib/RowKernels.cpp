@@ -0,0 +1,155 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 2002, 2005
+ * Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+
+#include "RowKernels.h"
+
+#ifdef ROWKERNELS_SSE2
+#	include <emmintrin.h>
+#endif
+
+//**********************************************************************************
+void CRowKernels::ScaleRow32(
+//Multiplies each byte of a row of 32-bit pixels by the 8.8 fixed-point factor
+//for that byte's position in the pixel, capping at 255.
+//
+//Params:
+	Uint8 *pDest,            //(in/out) start of row
+	const Uint8 *pMask,      //(in) if not NULL, pixels matching key in this row are skipped
+	const PixelKey32 &key,
+	const UINT wPixels,
+	const Uint16 factors[4])
+{
+	UINT wPixel = 0;
+#ifdef ROWKERNELS_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i vFactors = _mm_set_epi16(
+			factors[3], factors[2], factors[1], factors[0],
+			factors[3], factors[2], factors[1], factors[0]);
+	const __m128i vCap = _mm_set1_epi16(short(0xff00));
+	const __m128i vKeyMask = _mm_set1_epi32(int(key.dwMask));
+	const __m128i vKey = _mm_set1_epi32(int(key.dwKey));
+	for ( ; wPixel + 4 <= wPixels; wPixel += 4, pDest += 16)
+	{
+		const __m128i pixels = _mm_loadu_si128((const __m128i*)pDest);
+
+		//Each byte moved to the high half of a 16-bit lane, so mulhi yields byte*factor/256.
+		__m128i lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, pixels), vFactors);
+		__m128i hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, pixels), vFactors);
+
+		//Cap at 255 before packing.
+		lo = _mm_subs_epu16(_mm_adds_epu16(lo, vCap), vCap);
+		hi = _mm_subs_epu16(_mm_adds_epu16(hi, vCap), vCap);
+		__m128i result = _mm_packus_epi16(lo, hi);
+
+		if (pMask)
+		{
+			const __m128i mask = _mm_loadu_si128((const __m128i*)pMask);
+			const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(mask, vKeyMask), vKey);
+			result = _mm_or_si128(_mm_and_si128(keyed, pixels), _mm_andnot_si128(keyed, result));
+			pMask += 16;
+		}
+		_mm_storeu_si128((__m128i*)pDest, result);
+	}
+#endif
+	ScaleRow32Scalar(pDest, pMask, key, wPixels - wPixel, factors);
+}
+
+//**********************************************************************************
+void CRowKernels::ScaleRow32Scalar(
+//ScaleRow32 one pixel at a time.
+//
+//Params:
+	Uint8 *pDest,            //(in/out) start of row
+	const Uint8 *pMask,      //(in) if not NULL, pixels matching key in this row are skipped
+	const PixelKey32 &key,
+	const UINT wPixels,
+	const Uint16 factors[4])
+{
+	for (UINT wPixel = 0; wPixel < wPixels; ++wPixel, pDest += 4)
+	{
+		if (pMask)
+		{
+			const bool bKeyed = key.IsKeyed(pMask);
+			pMask += 4;
+			if (bKeyed)
+				continue;
+		}
+		for (UINT i=0; i<4; ++i)
+		{
+			const UINT wVal = (pDest[i] * factors[i]) >> 8;
+			pDest[i] = static_cast<Uint8>(wVal < 255 ? wVal : 255);
+		}
+	}
+}
+
+//**********************************************************************************
+void CRowKernels::ShadeRow32(
+//Averages (rounding down) each color byte of a row of 32-bit pixels with the
+//corresponding byte of a color.  Bytes that are zero in byteMask are kept.
+//
+//Params:
+	Uint8 *pDest,            //(in/out) start of row
+	const UINT wPixels,
+	const Uint8 colorBytes[4], const Uint8 byteMask[4])
+{
+	UINT wPixel = 0;
+#ifdef ROWKERNELS_SSE2
+	Uint32 dwColor, dwByteMask;
+	memcpy(&dwColor, colorBytes, 4);
+	memcpy(&dwByteMask, byteMask, 4);
+	const __m128i vColor = _mm_set1_epi32(int(dwColor));
+	const __m128i vByteMask = _mm_set1_epi32(int(dwByteMask));
+	const __m128i vOne = _mm_set1_epi8(1);
+	for ( ; wPixel + 4 <= wPixels; wPixel += 4, pDest += 16)
+	{
+		const __m128i pixels = _mm_loadu_si128((const __m128i*)pDest);
+
+		//avg_epu8 rounds up; subtract the odd bit to round down.
+		const __m128i odd = _mm_and_si128(_mm_xor_si128(pixels, vColor), vOne);
+		const __m128i shaded = _mm_sub_epi8(_mm_avg_epu8(pixels, vColor), odd);
+		const __m128i result = _mm_or_si128(_mm_and_si128(vByteMask, shaded),
+				_mm_andnot_si128(vByteMask, pixels));
+		_mm_storeu_si128((__m128i*)pDest, result);
+	}
+#endif
+	ShadeRow32Scalar(pDest, wPixels - wPixel, colorBytes, byteMask);
+}
+
+//**********************************************************************************
+void CRowKernels::ShadeRow32Scalar(
+//ShadeRow32 one pixel at a time.
+//
+//Params:
+	Uint8 *pDest,            //(in/out) start of row
+	const UINT wPixels,
+	const Uint8 colorBytes[4], const Uint8 byteMask[4])
+{
+	for (UINT wPixel = 0; wPixel < wPixels; ++wPixel, pDest += 4)
+		for (UINT i=0; i<4; ++i)
+			if (byteMask[i])
+				pDest[i] = static_cast<Uint8>((pDest[i] + colorBytes[i]) / 2);
+}
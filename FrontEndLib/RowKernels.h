@@ -0,0 +1,90 @@
+// $Id$
+
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is Deadly Rooms of Death.
+ *
+ * The Initial Developer of the Original Code is
+ * Caravel Software.
+ * Portions created by the Initial Developer are Copyright (C) 2002, 2005
+ * Caravel Software. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+
+//Row kernels for 32-bit pixels used by the lighting and darkening routines.
+//
+//Each kernel has a plain C++ version that every build uses for the pixels
+//left over at the end of a row.  Where the compiler targets SSE2 (always on
+//x86-64), ROWKERNELS_SSE2 is defined and the kernels do four pixels at a time
+//with the same arithmetic, so results don't depend on where a row is split.
+
+#ifndef ROWKERNELS_H
+#define ROWKERNELS_H
+
+#include "Colors.h"
+#include <BackEndLib/Types.h>
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define ROWKERNELS_SSE2
+#endif
+
+//*****************************************************************************
+struct PixelKey32
+//Identifies color-keyed pixels of a 32-bit mask surface.
+{
+	PixelKey32() : dwMask(0), dwKey(0) {}
+	PixelKey32(const Uint8 color[3]) {
+		Uint8 mask[4] = {0,0,0,0}, key[4] = {0,0,0,0};
+		for (UINT i=0; i<3; ++i)
+		{
+			mask[PIXEL_FUDGE_FACTOR + i] = 0xff;
+			key[PIXEL_FUDGE_FACTOR + i] = color[i];
+		}
+		memcpy(&this->dwMask, mask, 4);
+		memcpy(&this->dwKey, key, 4);
+	}
+	inline bool IsKeyed(const Uint8 *pPixel) const {
+		Uint32 dwPixel;
+		memcpy(&dwPixel, pPixel, 4);
+		return (dwPixel & this->dwMask) == this->dwKey;
+	}
+
+	Uint32 dwMask, dwKey;
+};
+
+//*****************************************************************************
+class CRowKernels
+{
+public:
+	static inline Uint16 FixedPoint8_8(const float fFactor) {
+		return static_cast<Uint16>(fFactor * 256.0f + 0.5f);
+	}
+
+	static void ScaleRow32(Uint8 *pDest, const Uint8 *pMask, const PixelKey32 &key,
+			const UINT wPixels, const Uint16 factors[4]);
+	static void ScaleRow32Scalar(Uint8 *pDest, const Uint8 *pMask, const PixelKey32 &key,
+			const UINT wPixels, const Uint16 factors[4]);
+
+	static void ShadeRow32(Uint8 *pDest, const UINT wPixels,
+			const Uint8 colorBytes[4], const Uint8 byteMask[4]);
+	static void ShadeRow32Scalar(Uint8 *pDest, const UINT wPixels,
+			const Uint8 colorBytes[4], const Uint8 byteMask[4]);
+};
+
+#endif //...#ifndef ROWKERNELS_H
@@ -196,6 +196,30 @@ inline bool doubleWithClamp(int& val)
 	return true;
 }
 
+//*****************************************************************************
+inline ULONGLONG RoundOfHit(const ULONGLONG hitNumber, const UINT startTicks, const UINT speed)
+//Returns: the round of combat on which an entity makes its Nth hit (the first round is 1)
+//
+//Pre-condition: the entity never has enough ticks amassed for two hits in one round
+{
+	const ULONGLONG ticksNeeded = hitNumber * CCombat::hitTicks;
+	if (ticksNeeded <= startTicks)
+		return 1;
+	const ULONGLONG rounds = (ticksNeeded - startTicks + speed - 1) / speed;
+	return rounds ? rounds : 1;
+}
+
+//*****************************************************************************
+inline ULONGLONG HitsInRounds(const ULONGLONG rounds, const UINT startTicks, const UINT speed)
+//Returns: how many hits an entity makes in the first N rounds of combat
+//
+//Pre-condition: as for RoundOfHit
+{
+	if (!rounds)
+		return 0;
+	return (startTicks + rounds * speed) / CCombat::hitTicks;
+}
+
 //*****************************************************************************
 CCombat::CCombat(
 		CCurrentGame* pCurrentGame, CMonster* pMonster,
@@ -897,6 +921,11 @@ int CCombat::GetExpectedDamage()
 	if (!this->pMonster->IsCombatable())
 		return -1;
 
+	//Most fights can be resolved directly.
+	int damage;
+	if (PredictStandardCombat(damage))
+		return damage;
+
 	//Simulate the combat without changing any player stats.
 	CCueEvents Ignored;
 	CSwordsman& player = *this->pGame->pPlayer;
@@ -908,7 +937,7 @@ int CCombat::GetExpectedDamage()
 	player.st.HP = MAX_HP; //give player max HP for total damage calculation
 	Advance(Ignored, true);
 	const UINT uDamage = UINT(MAX_HP) - player.st.HP;
-	int damage = uDamage >= INT_MAX ? INT_MAX : uDamage;
+	damage = uDamage >= INT_MAX ? INT_MAX : uDamage;
 
 	//Restore original state.
 	this->bSimulated = false;
@@ -918,6 +947,114 @@ int CCombat::GetExpectedDamage()
 	return damage;
 }
 
+//*****************************************************************************
+bool CCombat::PredictStandardCombat(
+//Works out the result of a simulated fight without stepping through its rounds.
+//
+//This handles fights where every round goes the same way: each player hit does
+//the same damage (except for a backstab on the first one), each monster hit does
+//the same damage or none, and neither side ever gets two hits in one round.
+//The first rounds' backstab and turning to face the player are accounted for.
+//
+//Returns: whether the fight could be predicted.  If not, combat progress is unchanged.
+//
+//Params:
+	int& damage) //(out) damage the player would suffer, as returned by GetExpectedDamage
+{
+	ASSERT(this->pGame);
+	ASSERT(this->pMonster);
+	const CSwordsman& player = *this->pGame->pPlayer;
+
+	//Only a fight just starting against a single monster.
+	if (this->bFightNextMonsterInQueue || !this->queuedCombat.empty() || this->bEndCombat ||
+			this->playerAttacksMade || this->monsterAttacksMade || this->noDamageHits ||
+			!this->pGame->bIsGameActive || !this->pMonster->IsAlive())
+		return false;
+	const UINT monHP = this->pMonster->getHP();
+	if (!monHP)
+		return false;
+
+	//Ticks must never amass enough for two hits in one round.
+	const UINT playerSpeed = player.st.speed * (player.IsHasted() ? 2 : 1);
+	if (!playerSpeed || playerSpeed > CCombat::hitTicks || MON_SPEED > CCombat::hitTicks ||
+			ULONGLONG(this->playerTicks) + playerSpeed >= 2 * ULONGLONG(CCombat::hitTicks) ||
+			ULONGLONG(this->monsterTicks) + MON_SPEED >= 2 * ULONGLONG(CCombat::hitTicks))
+		return false;
+
+	//Player's ATK+DEF don't change during a simulated fight.
+	this->plATK = getPlayerATK();
+	this->plDEF = getPlayerDEF();
+	const int plATK = this->plATK;
+
+	int monCombatDEF = (int)this->monDEF;
+	if (this->bPlayerDoesNoDefenseHit && monCombatDEF > 0)
+		monCombatDEF = 0;
+	if (plATK <= monCombatDEF)
+		return false; //only a backstab could do damage
+
+	//When the monster can't harm the player, its blocked hits end the fight early
+	//if it makes three between two of the player's.  That can't happen unless
+	//the player is slower than the monster.
+	const bool bMonsterHarmsPlayer = (int)this->monATK > this->plDEF;
+	if (!bMonsterHarmsPlayer && playerSpeed < MON_SPEED)
+		return false;
+
+	//The player's first hit is a backstab unless the monster acts first.
+	int dx, dy;
+	const bool bAttackIsBehindMonster = AttackIsFromBehindMonster(dx, dy);
+	int firstATK = plATK;
+	if (this->bPlayerBackstabs && bAttackIsBehindMonster &&
+			RoundOfHit(1, this->playerTicks, playerSpeed) <= RoundOfHit(1, this->monsterTicks, MON_SPEED))
+		doubleWithClamp(firstATK);
+
+	//Number of hits for the player to defeat the monster.
+	const UINT firstDelta = firstATK - monCombatDEF;
+	const UINT delta = plATK - monCombatDEF;
+	ULONGLONG playerHits = 1;
+	UINT monsterHPOnFinalRound = monHP;
+	if (firstDelta < monHP)
+	{
+		const ULONGLONG hpLeft = monHP - firstDelta;
+		const ULONGLONG moreHits = (hpLeft + delta - 1) / delta;
+		playerHits += moreHits;
+		monsterHPOnFinalRound = UINT(hpLeft - (moreHits - 1) * delta);
+	}
+
+	//The monster gets its turns on each round before the one it is defeated on.
+	const ULONGLONG finalRound = RoundOfHit(playerHits, this->playerTicks, playerSpeed);
+	const ULONGLONG monsterTurns = HitsInRounds(finalRound - 1, this->monsterTicks, MON_SPEED);
+	ULONGLONG monsterHits = monsterTurns;
+	if (monsterTurns && bAttackIsBehindMonster &&
+			this->pMonster->TurnToFacePlayerWhenFighting() && this->pMonster->HasOrientation())
+		--monsterHits; //monster spends its first turn turning to face the player
+	if (playerHits > UINT(-1) || monsterHits > UINT(-1))
+		return false;
+
+	const ULONGLONG totalDamage = bMonsterHarmsPlayer ?
+			monsterHits * GetMonsterSingleAttackDamage() : 0;
+
+	//Leave combat state as Advance would have.
+	this->playerAttacksMade = UINT(playerHits);
+	this->monsterAttacksMade = UINT(monsterHits);
+	this->monsterHPOnFinalRound = monsterHPOnFinalRound;
+	this->playerTicks = UINT(this->playerTicks + finalRound * playerSpeed -
+			playerHits * CCombat::hitTicks);
+	this->monsterTicks = UINT(this->monsterTicks + finalRound * MON_SPEED -
+			monsterTurns * CCombat::hitTicks);
+	this->bPlayerBackstabs = false;
+	if (totalDamage < ULONGLONG(MAX_HP))
+	{
+		//Player survived to defeat the monster.
+		this->pDefeatedMonster = this->pMonster;
+		this->bEndCombat = true;
+	} else {
+		this->pDefeatedMonster = NULL;
+	}
+
+	damage = totalDamage >= ULONGLONG(INT_MAX) ? INT_MAX : int(totalDamage);
+	return true;
+}
+
 //*****************************************************************************
 bool CCombat::PlayerCanHarmMonster(CMonster *pMonster) const
 //Returns: whether player has the power to harm this monster
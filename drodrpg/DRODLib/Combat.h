@@ -163,6 +163,7 @@ private:
 
 	bool BeginFightingNextQueuedMonster(CCueEvents& CueEvents);
 	bool FightNextMonster(CCueEvents& CueEvents);
+	bool PredictStandardCombat(int& damage);
 
 	int  getPlayerATK();
 	int  getPlayerDEF();
@@ -1350,9 +1350,12 @@ void CDbBase::deleteMessages(const CIDSet& messageIDs, const CIDSet& rowIDs)
 			message != messageIndex.end(); ++message)
 	{
 		//Correct row index for each messageTextID belonging to this messageID.
+		//Offsets never decrease with row index, so the corrected rows remain
+		//in the same order.
 		CIDSet& ids = message->second;
-		CIDSet::iterator messageTextRow = ids.begin();
-		while (messageTextRow != ids.end())
+		CIDSet shiftedRows;
+		for (CIDSet::const_iterator messageTextRow = ids.begin();
+				messageTextRow != ids.end(); ++messageTextRow)
 		{
 			//Tally how many rows before this row have been deleted.
 			const UINT oldRow = *messageTextRow;
@@ -1364,17 +1367,11 @@ void CDbBase::deleteMessages(const CIDSet& messageIDs, const CIDSet& rowIDs)
 					break; //no more rows before the old row have been deleted
 			}
 
-			if (rowOffset)
-			{
-				//We can replace a value in this set with a lower value this way.
-				messageTextRow = ids.erase(messageTextRow); //increments iterator
-				ASSERT(oldRow >= rowOffset);
-				ASSERT(!ids.has(oldRow - rowOffset)); //this row index shouldn't already be present in the set
-				ids += (oldRow - rowOffset);
-			} else {
-				++messageTextRow; //this messageText's row index has not changed
-			}
+			ASSERT(oldRow >= rowOffset);
+			ASSERT(!shiftedRows.has(oldRow - rowOffset)); //this row index shouldn't already be present in the set
+			shiftedRows += (oldRow - rowOffset);
 		}
+		ids = shiftedRows;
 	}
 }
 